@@ -153,7 +153,10 @@ static ident objectForItemAtIndexPath(const CollectionView *collectionView, cons
  */
 static CollectionItemView *itemForObjectAtIndexPath(const CollectionView *collectionView, const IndexPath *indexPath) {
 
-	CollectionItemView *item = $(alloc(CollectionItemView), initWithFrame, NULL);
+	CollectionItemView *item = $(collectionView, dequeueReusableItem);
+	if (item == NULL) {
+		item = $(alloc(CollectionItemView), initWithFrame, NULL);
+	}
 
 	char text[64];
 	snprintf(text, sizeof(text), "%zd", $(indexPath, indexAtPosition, 0));
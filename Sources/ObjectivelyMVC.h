@@ -34,13 +34,19 @@
 #include <ObjectivelyMVC/Checkbox.h>
 #include <ObjectivelyMVC/CollectionItemView.h>
 #include <ObjectivelyMVC/CollectionView.h>
+#include <ObjectivelyMVC/CollectionViewFlowLayout.h>
+#include <ObjectivelyMVC/CollectionViewLayout.h>
+#include <ObjectivelyMVC/CollectionViewMasonryLayout.h>
 #include <ObjectivelyMVC/Colors.h>
 #include <ObjectivelyMVC/Control.h>
+#include <ObjectivelyMVC/FlexView.h>
 #include <ObjectivelyMVC/Input.h>
 #include <ObjectivelyMVC/Font.h>
+#include <ObjectivelyMVC/GridView.h>
 #include <ObjectivelyMVC/Image.h>
 #include <ObjectivelyMVC/ImageView.h>
 #include <ObjectivelyMVC/Label.h>
+#include <ObjectivelyMVC/LayoutQueue.h>
 #include <ObjectivelyMVC/Log.h>
 #include <ObjectivelyMVC/NavigationViewController.h>
 #include <ObjectivelyMVC/Option.h>
@@ -58,6 +64,7 @@
 #include <ObjectivelyMVC/TableView.h>
 #include <ObjectivelyMVC/Text.h>
 #include <ObjectivelyMVC/TextView.h>
+#include <ObjectivelyMVC/ThumbnailLoader.h>
 #include <ObjectivelyMVC/Types.h>
 #include <ObjectivelyMVC/View.h>
 #include <ObjectivelyMVC/View+JSON.h>
@@ -117,9 +117,18 @@ static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
 }
 
 /**
- * @see View::draw(View *self, Renderer *renderer)
+ * @see View::init(View *)
+ */
+static View *init(View *self) {
+	return (View *) $((Checkbox *) self, initWithFrame, NULL, ControlStyleDefault);
+}
+
+/**
+ * @see View::willLayoutSubviews(View *)
  */
-static void draw(View *self, Renderer *renderer) {
+static void willLayoutSubviews(View *self) {
+
+	super(View, self, willLayoutSubviews);
 
 	Checkbox *this = (Checkbox *) self;
 
@@ -128,15 +137,6 @@ static void draw(View *self, Renderer *renderer) {
 	} else {
 		this->check->view.hidden = true;
 	}
-
-	super(View, self, draw, renderer);
-}
-
-/**
- * @see View::init(View *)
- */
-static View *init(View *self) {
-	return (View *) $((Checkbox *) self, initWithFrame, NULL, ControlStyleDefault);
 }
 
 #pragma mark - Control
@@ -212,9 +212,9 @@ static void initialize(Class *clazz) {
 
 	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
 
-	((ViewInterface *) clazz->def->interface)->draw = draw;
 	((ViewInterface *) clazz->def->interface)->awakeWithDictionary = awakeWithDictionary;
 	((ViewInterface *) clazz->def->interface)->init = init;
+	((ViewInterface *) clazz->def->interface)->willLayoutSubviews = willLayoutSubviews;
 
 	((ControlInterface *) clazz->def->interface)->captureEvent = captureEvent;
 
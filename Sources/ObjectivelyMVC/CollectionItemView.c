@@ -72,12 +72,25 @@ static CollectionItemView *initWithFrame(CollectionItemView *self, const SDL_Rec
 
 		self->view.borderColor = Colors.SelectedColor;
 
+		self->view.cachesLayout = true;
 		self->view.clipsSubviews = true;
 	}
 
 	return self;
 }
 
+/**
+ * @fn void CollectionItemView::prepareForReuse(CollectionItemView *self)
+ * @memberof CollectionItemView
+ */
+static void prepareForReuse(CollectionItemView *self) {
+
+	$(self, setSelected, false);
+
+	$(self->imageView, setImage, NULL);
+	$(self->text, setText, NULL);
+}
+
 /**
  * @fn void CollectionItemView::setSelected(CollectionItemView *self, _Bool selected)
  * @memberof CollectionItemView
@@ -102,6 +115,7 @@ static void initialize(Class *clazz) {
 	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
 
 	((CollectionItemViewInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
+	((CollectionItemViewInterface *) clazz->def->interface)->prepareForReuse = prepareForReuse;
 	((CollectionItemViewInterface *) clazz->def->interface)->setSelected = setSelected;
 }
 
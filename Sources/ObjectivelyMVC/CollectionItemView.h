@@ -89,6 +89,15 @@ struct CollectionItemViewInterface {
 	 */
 	CollectionItemView *(*initWithFrame)(CollectionItemView *self, const SDL_Rect *frame);
 
+	/**
+	 * @fn void CollectionItemView::prepareForReuse(CollectionItemView *self)
+	 * @brief Resets this item before it is returned by CollectionView::dequeueReusableItem.
+	 * @param self The CollectionItemView.
+	 * @remarks Subclasses should override this method to reset any state they add.
+	 * @memberof CollectionItemView
+	 */
+	void (*prepareForReuse)(CollectionItemView *self);
+
 	/**
 	 * @fn void CollectionItemView::setSelected(CollectionItemView *self, _Bool selected)
 	 * @brief Sets the selected state of this item.
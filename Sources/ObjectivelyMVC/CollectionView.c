@@ -22,6 +22,8 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <ObjectivelyMVC/CollectionView.h>
 
@@ -32,6 +34,189 @@ const EnumName CollectionViewAxisNames[] = MakeEnumNames(
 
 #define _Class _CollectionView
 
+#define SELECTION_WORD_BITS 64
+
+/**
+ * @return The count of words in the selection bitset for `count` items.
+ */
+static size_t selectionWords(size_t count) {
+	return (count + SELECTION_WORD_BITS - 1) / SELECTION_WORD_BITS;
+}
+
+/**
+ * @return True if the item at `index` is selected in the given bitset.
+ */
+static _Bool isItemSelected(const uint64_t *selection, size_t index) {
+	return (selection[index / SELECTION_WORD_BITS] >> (index % SELECTION_WORD_BITS)) & 1;
+}
+
+/**
+ * @brief Selects or deselects the items in `[start, end)`.
+ * @remarks Only items whose selection actually changes are updated, and words that need no
+ * change are skipped, so clearing a sparse selection is proportional to the count of words.
+ */
+static void setItemsSelected(CollectionView *self, size_t start, size_t end, _Bool selected) {
+
+	const Array *items = (Array *) self->items;
+
+	end = min(end, items->count);
+
+	for (size_t i = start; i < end; ) {
+
+		const size_t word = i / SELECTION_WORD_BITS;
+		const size_t bit = i % SELECTION_WORD_BITS;
+		const size_t bits = min(SELECTION_WORD_BITS - bit, end - i);
+
+		uint64_t mask = bits == SELECTION_WORD_BITS ? ~0ULL : ((1ULL << bits) - 1) << bit;
+
+		const uint64_t current = self->selection[word];
+		uint64_t changed = (selected ? ~current : current) & mask;
+
+		if (changed) {
+			self->selection[word] ^= changed;
+
+			while (changed) {
+				const size_t index = word * SELECTION_WORD_BITS + __builtin_ctzll(changed);
+				CollectionItemView *item = $(items, objectAtIndex, index);
+				$(item, setSelected, selected);
+
+				changed &= changed - 1;
+			}
+		}
+
+		i += bits;
+	}
+}
+
+/**
+ * @brief Converts the given point in window coordinates to the content View's bounds.
+ */
+static SDL_Point contentPoint(const CollectionView *self, const SDL_Point *point) {
+
+	const SDL_Rect frame = $(self->contentView, renderFrame);
+
+	return MakePoint(point->x - frame.x - self->contentView->padding.left, point->y - frame.y - self->contentView->padding.top);
+}
+
+/**
+ * @brief CollectionViewLayoutEnumerator for hit testing.
+ */
+static void itemIndexAtPoint_enumerate(const CollectionViewLayout *layout, size_t index, ident data) {
+	*(ssize_t *) data = index;
+}
+
+/**
+ * @brief Begins tracking a rubber-band selection at the given point.
+ */
+static void beginRubberBand(CollectionView *self, const SDL_Point *point) {
+
+	self->rubberBandOrigin = contentPoint(self, point);
+	self->rubberBand = MakeRect(0, 0, -1, -1);
+
+	if ((SDL_GetModState() & (KMOD_SHIFT | KMOD_CTRL | KMOD_GUI)) == 0) {
+		$(self, deselectAll);
+	}
+
+	if (self->selection) {
+		memcpy(self->rubberBandSelection, self->selection, selectionWords(self->items->array.count) * sizeof(uint64_t));
+	}
+
+	self->isRubberBanding = true;
+}
+
+/**
+ * @brief CollectionViewLayoutEnumerator restoring items that the rubber-band no longer covers.
+ */
+static void updateRubberBand_restore(const CollectionViewLayout *layout, size_t index, ident data) {
+
+	CollectionView *this = data;
+
+	const SDL_Rect *frame = layout->attributes + index;
+	if (SDL_HasIntersection(frame, &this->rubberBand) == false) {
+		setItemsSelected(this, index, index + 1, isItemSelected(this->rubberBandSelection, index));
+	}
+}
+
+/**
+ * @brief CollectionViewLayoutEnumerator selecting items that the rubber-band covers.
+ */
+static void updateRubberBand_select(const CollectionViewLayout *layout, size_t index, ident data) {
+	setItemsSelected((CollectionView *) data, index, index + 1, true);
+}
+
+/**
+ * @brief Extends the rubber-band to the given point, updating the selection.
+ * @remarks Only the items covered by the previous or the new rubber-band are visited, so the
+ * cost is proportional to the area of the rubber-band rather than to the count of items.
+ */
+static void updateRubberBand(CollectionView *self, const SDL_Point *point) {
+
+	const SDL_Point p = contentPoint(self, point);
+
+	const SDL_Rect previous = self->rubberBand;
+
+	self->rubberBand = MakeRect(
+		min(p.x, self->rubberBandOrigin.x),
+		min(p.y, self->rubberBandOrigin.y),
+		max(abs(p.x - self->rubberBandOrigin.x), 1),
+		max(abs(p.y - self->rubberBandOrigin.y), 1)
+	);
+
+	if (previous.w > -1) {
+		$(self->layout, enumerateItemsInRect, &previous, updateRubberBand_restore, self);
+	}
+
+	$(self->layout, enumerateItemsInRect, &self->rubberBand, updateRubberBand_select, self);
+}
+
+/**
+ * @return The shared IndexPath of the given item index.
+ */
+static IndexPath *indexPathForIndex(const CollectionView *self, size_t index) {
+
+	const Array *indexPaths = (Array *) self->indexPaths;
+	while (indexPaths->count <= index) {
+
+		IndexPath *indexPath = $(alloc(IndexPath), initWithIndex, indexPaths->count);
+		assert(indexPath);
+
+		$(self->indexPaths, addObject, indexPath);
+		release(indexPath);
+	}
+
+	return $(indexPaths, objectAtIndex, index);
+}
+
+/**
+ * @brief Notifies the delegate of a change in selection.
+ */
+static void selectionDidChange(CollectionView *self) {
+
+	if (self->delegate.didModifySelection) {
+		Array *selectionIndexPaths = $(self, selectionIndexPaths);
+
+		self->delegate.didModifySelection(self, selectionIndexPaths);
+
+		release(selectionIndexPaths);
+	}
+
+	if (self->delegate.didModifySelectionRanges) {
+
+		const size_t count = $(self, selectionRanges, NULL, 0);
+		if (count > self->selectionRangesCapacity) {
+
+			self->selectionRangesBuffer = realloc(self->selectionRangesBuffer, count * sizeof(Range));
+			assert(self->selectionRangesBuffer);
+
+			self->selectionRangesCapacity = count;
+		}
+
+		$(self, selectionRanges, self->selectionRangesBuffer, count);
+
+		self->delegate.didModifySelectionRanges(self, self->selectionRangesBuffer, count);
+	}
+}
+
 #pragma mark - Object
 
 /**
@@ -42,9 +227,21 @@ static void dealloc(Object *self) {
 	CollectionView *this = (CollectionView *) self;
 
 	release(this->contentView);
+	release(this->indexPaths);
 	release(this->items);
+	release(this->layout);
+	release(this->reusableItems);
 	release(this->scrollView);
 
+	if (this->thumbnailLoader) {
+		$(this->thumbnailLoader, cancelAll);
+		release(this->thumbnailLoader);
+	}
+
+	free(this->rubberBandSelection);
+	free(this->selection);
+	free(this->selectionRangesBuffer);
+
 	super(Object, self, dealloc);
 }
 
@@ -68,6 +265,20 @@ static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
 	$(self, bind, dictionary, inlets);
 }
 
+/**
+ * @see View::didLayoutSubviews(View *)
+ */
+static void didLayoutSubviews(View *self) {
+
+	super(View, self, didLayoutSubviews);
+
+	CollectionView *this = (CollectionView *) self;
+
+	if (this->thumbnailLoader) {
+		$(this->thumbnailLoader, dispatch);
+	}
+}
+
 /**
  * @see View::init(View *)
  */
@@ -82,38 +293,27 @@ static void layoutSubviews(View *self) {
 
 	CollectionView *this = (CollectionView *) self;
 
-	const SDL_Rect bounds = $(self, bounds);
+	$(this->layout, prepareLayout, this);
 
-	int x = bounds.x, y = bounds.y;
+	const SDL_Rect *attributes = this->layout->attributes;
 
 	const Array *items = (Array *) this->items;
 	for (size_t i = 0; i < items->count; i++) {
 
 		CollectionItemView *item = (CollectionItemView *) $(items, objectAtIndex, i);
-
-		item->view.frame.x = x;
-		item->view.frame.y = y;
-		item->view.frame.w = this->itemSize.w;
-		item->view.frame.h = this->itemSize.h;
-
-		switch (this->axis) {
-			case CollectionViewAxisVertical:
-				x += this->itemSize.w + this->itemSpacing.w;
-				if (x + this->itemSize.w > bounds.w) {
-					y += this->itemSize.h + this->itemSpacing.h;
-					x = bounds.x;
-				}
-				break;
-			case CollectionViewAxisHorizontal:
-				y += this->itemSize.h + this->itemSpacing.h;
-				if (y + this->itemSize.h > bounds.h) {
-					x += this->itemSize.w + this->itemSpacing.w;
-					y = bounds.y;
-				}
-				break;
-		}
+		item->view.frame = attributes[i];
 	}
 
+	const ViewPadding padding = this->contentView->padding;
+	const SDL_Size contentSize = this->layout->contentSize;
+
+	const SDL_Size size = MakeSize(
+		contentSize.w + padding.left + padding.right,
+		contentSize.h + padding.top + padding.bottom
+	);
+
+	$(this->contentView, resize, &size);
+
 	super(View, self, layoutSubviews);
 }
 
@@ -124,9 +324,48 @@ static void layoutSubviews(View *self) {
  */
 static _Bool captureEvent(Control *self, const SDL_Event *event) {
 
-	if (event->type == SDL_MOUSEBUTTONUP) {
+	CollectionView *this = (CollectionView *) self;
+
+	if (event->type == SDL_MOUSEBUTTONDOWN && event->button.button == SDL_BUTTON_LEFT) {
+
+		if (self->selection == ControlSelectionMultiple) {
+			if ($((View *) this->contentView, didReceiveEvent, event)) {
+
+				const SDL_Point point = {
+					.x = event->button.x,
+					.y = event->button.y
+				};
+
+				if ((SDL_GetModState() & (KMOD_SHIFT | KMOD_CTRL | KMOD_GUI)) || $(this, itemIndexAtPoint, &point) == -1) {
+					beginRubberBand(this, &point);
+					return true;
+				}
+			}
+		}
+
+	} else if (event->type == SDL_MOUSEMOTION && this->isRubberBanding) {
+
+		if (event->motion.state & SDL_BUTTON_LMASK) {
+
+			const SDL_Point point = {
+				.x = event->motion.x,
+				.y = event->motion.y
+			};
+
+			updateRubberBand(this, &point);
+			return true;
+		}
+
+	} else if (event->type == SDL_MOUSEBUTTONUP) {
 
-		CollectionView *this = (CollectionView *) self;
+		if (this->isRubberBanding) {
+			this->isRubberBanding = false;
+
+			if (this->rubberBand.w > -1) {
+				selectionDidChange(this);
+				return true;
+			}
+		}
 
 		if ($((Control *) this->scrollView, highlighted) == false) {
 			if ($((View *) this->contentView, didReceiveEvent, event)) {
@@ -136,44 +375,42 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
 					.y = event->button.y
 				};
 
-				IndexPath *indexPath = $(this, indexPathForItemAtPoint, &point);
+				const ssize_t index = $(this, itemIndexAtPoint, &point);
+				if (index > -1) {
 
-				const CollectionItemView *item = $(this, itemAtIndexPath, indexPath);
-				if (item) {
+					const _Bool selected = isItemSelected(this->selection, index);
 
 					switch (self->selection) {
 						case ControlSelectionNone:
 							break;
 						case ControlSelectionSingle:
-							if (item->isSelected == false) {
+							if (selected == false) {
 								$(this, deselectAll);
-								$(this, selectItemAtIndexPath, indexPath);
+								setItemsSelected(this, index, index + 1, true);
 							}
+							this->selectionAnchor = index;
 							break;
 						case ControlSelectionMultiple:
-							if (SDL_GetModState() & (KMOD_CTRL | KMOD_GUI)) {
-								if (item->isSelected) {
-									$(this, deselectItemAtIndexPath, indexPath);
-								} else {
-									$(this, selectItemAtIndexPath, indexPath);
+							if ((SDL_GetModState() & KMOD_SHIFT) && this->selectionAnchor > -1) {
+								if ((SDL_GetModState() & (KMOD_CTRL | KMOD_GUI)) == 0) {
+									$(this, deselectAll);
 								}
+								const size_t anchor = this->selectionAnchor;
+								setItemsSelected(this, min(anchor, (size_t) index), max(anchor, (size_t) index) + 1, true);
+							} else if (SDL_GetModState() & (KMOD_CTRL | KMOD_GUI)) {
+								setItemsSelected(this, index, index + 1, !selected);
+								this->selectionAnchor = index;
 							} else {
 								$(this, deselectAll);
-								$(this, selectItemAtIndexPath, indexPath);
+								setItemsSelected(this, index, index + 1, true);
+								this->selectionAnchor = index;
 							}
 							break;
 					}
 
-					if (this->delegate.didModifySelection) {
-						Array *selectionIndexPaths = $(this, selectionIndexPaths);
-
-						this->delegate.didModifySelection(this, selectionIndexPaths);
-
-						release(selectionIndexPaths);
-					}
+					selectionDidChange(this);
 				}
 
-				release(indexPath);
 				return true;
 			}
 		}
@@ -184,19 +421,12 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
 
 #pragma mark - CollectionView
 
-/**
- * @brief ArrayEnumerator for all item deselection.
- */
-static void deselectAll_enumerate(const Array *array, ident obj, ident data) {
-	$((CollectionItemView *) obj, setSelected, false);
-}
-
 /**
  * @fn void CollectionView::deselectAll(CollectionView *self)
  * @memberof CollectionView
  */
 static void deselectAll(CollectionView *self) {
-	$((Array *) self->items, enumerateObjects, deselectAll_enumerate, NULL);
+	setItemsSelected(self, 0, self->items->array.count, false);
 }
 
 /**
@@ -206,10 +436,8 @@ static void deselectAll(CollectionView *self) {
 static void deselectItemAtIndexPath(CollectionView *self, const IndexPath *indexPath) {
 
 	if (indexPath) {
-		CollectionItemView *item = $(self, itemAtIndexPath, indexPath);
-		if (item) {
-			$(item, setSelected, false);
-		}
+		const size_t index = $(indexPath, indexAtPosition, 0);
+		setItemsSelected(self, index, index + 1, false);
 	}
 }
 
@@ -217,7 +445,7 @@ static void deselectItemAtIndexPath(CollectionView *self, const IndexPath *index
  * @brief ArrayEnumerator for item deselection.
  */
 static void deselectItemsAtIndexPaths_enumerate(const Array *array, ident obj, ident data) {
-	$((CollectionItemView *) obj, setSelected, false);
+	$((CollectionView *) data, deselectItemAtIndexPath, (IndexPath *) obj);
 }
 
 /**
@@ -232,40 +460,43 @@ static void deselectItemsAtIndexPaths(CollectionView *self, const Array *indexPa
 }
 
 /**
- * @fn IndexPath *CollectionView::indexPathForItemAtPoint(const CollectionView *self, const SDL_Point *point)
+ * @fn void CollectionView::deselectItemsInRange(CollectionView *self, const Range range)
  * @memberof CollectionView
  */
-static IndexPath *indexPathForItemAtPoint(const CollectionView *self, const SDL_Point *point) {
+static void deselectItemsInRange(CollectionView *self, const Range range) {
 
-	if (self->itemSize.w && self->itemSize.h) {
+	const size_t start = max(range.location, 0);
+	const size_t end = (size_t) max(range.location + (ssize_t) range.length, 0);
 
-		const SDL_Rect frame = $(self->contentView, renderFrame);
+	setItemsSelected(self, start, end, false);
+}
 
-		const int itemWidth = self->itemSize.w + self->itemSpacing.w;
-		const int itemHeight = self->itemSize.h + self->itemSpacing.h;
+/**
+ * @fn CollectionItemView *CollectionView::dequeueReusableItem(const CollectionView *self)
+ * @memberof CollectionView
+ */
+static CollectionItemView *dequeueReusableItem(const CollectionView *self) {
 
-		const int rows = frame.h / itemHeight;
-		const int cols = frame.w / itemWidth;
+	CollectionItemView *item = $((Array *) self->reusableItems, lastObject);
+	if (item) {
+		retain(item);
+		$(self->reusableItems, removeLastObject);
 
-		const int x = point->x - frame.x;
-		const int y = point->y - frame.y;
+		$(item, prepareForReuse);
+	}
 
-		const int row = y / itemHeight;
-		const int col = x / itemWidth;
+	return item;
+}
 
-		int index;
-		switch (self->axis) {
-			case CollectionViewAxisVertical:
-				index = row * cols + col;
-				break;
-			case CollectionViewAxisHorizontal:
-				index = col * rows + row;
-				break;
-		}
+/**
+ * @fn IndexPath *CollectionView::indexPathForItemAtPoint(const CollectionView *self, const SDL_Point *point)
+ * @memberof CollectionView
+ */
+static IndexPath *indexPathForItemAtPoint(const CollectionView *self, const SDL_Point *point) {
 
-		if (index < self->items->array.count) {
-			return $(alloc(IndexPath), initWithIndex, index);
-		}
+	const ssize_t index = $(self, itemIndexAtPoint, point);
+	if (index > -1) {
+		return retain(indexPathForIndex(self, index));
 	}
 
 	return NULL;
@@ -279,7 +510,7 @@ static IndexPath *indexPathForItem(const CollectionView *self, const CollectionI
 
 	const ssize_t index = $((Array *) self->items, indexOfObject, (ident) item);
 	if (index > -1) {
-		return $(alloc(IndexPath), initWithIndex, index);
+		return retain(indexPathForIndex(self, index));
 	}
 
 	return NULL;
@@ -293,13 +524,23 @@ static CollectionView *initWithFrame(CollectionView *self, const SDL_Rect *frame
 
 	self = (CollectionView *) super(Control, self, initWithFrame, frame, style);
 	if (self) {
+		self->control.view.defersLayoutDuringLiveResize = true;
+
+		self->indexPaths = $$(MutableArray, array);
+		assert(self->indexPaths);
 
 		self->items = $$(MutableArray, array);
 
+		self->reusableItems = $$(MutableArray, array);
+		assert(self->reusableItems);
+
+		self->selectionAnchor = -1;
+
 		self->contentView = $(alloc(View), initWithFrame, NULL);
 		assert(self->contentView);
 
-		self->contentView->autoresizingMask = ViewAutoresizingContain;
+		self->layout = $(alloc(CollectionViewLayout), init);
+		assert(self->layout);
 
 		self->scrollView = $(alloc(ScrollView), initWithFrame, NULL, style);
 		assert(self->scrollView);
@@ -355,10 +596,22 @@ static CollectionItemView *itemAtIndexPath(const CollectionView *self, const Ind
 }
 
 /**
- * @brief ArrayEnumerator to remove CollectionItemViews from the collection's contentView.
+ * @fn ssize_t CollectionView::itemIndexAtPoint(const CollectionView *self, const SDL_Point *point)
+ * @memberof CollectionView
  */
-static void reloadData_removeItems(const Array *array, ident obj, ident data) {
-	$((View *) data, removeSubview, (View *) obj);
+static ssize_t itemIndexAtPoint(const CollectionView *self, const SDL_Point *point) {
+
+	const SDL_Point p = contentPoint(self, point);
+	const SDL_Rect rect = MakeRect(p.x, p.y, 1, 1);
+
+	ssize_t index = -1;
+	$(self->layout, enumerateItemsInRect, &rect, itemIndexAtPoint_enumerate, &index);
+
+	if (index >= (ssize_t) self->items->array.count) {
+		index = -1;
+	}
+
+	return index;
 }
 
 /**
@@ -370,32 +623,48 @@ static void reloadData(CollectionView *self) {
 	assert(self->dataSource.numberOfItems);
 	assert(self->delegate.itemForObjectAtIndexPath);
 
-	$((Array *) self->items, enumerateObjects, reloadData_removeItems, self->contentView);
+	if (self->thumbnailLoader) {
+		$(self->thumbnailLoader, cancelAll);
+	}
+
+	$(self->contentView, removeAllSubviews);
+
+	$(self->reusableItems, addObjectsFromArray, (Array *) self->items);
 	$(self->items, removeAllObjects);
 
 	const size_t numberOfItems = self->dataSource.numberOfItems(self);
 	for (size_t i = 0; i < numberOfItems; i++) {
 
-		IndexPath *indexPath = $(alloc(IndexPath), initWithIndex, i);
+		const IndexPath *indexPath = indexPathForIndex(self, i);
 
 		CollectionItemView *item = self->delegate.itemForObjectAtIndexPath(self, indexPath);
 		assert(item);
 
 		$(self->items, addObject, item);
-		$(self->contentView, addSubview, (View *) item);
 
 		release(item);
-		release(indexPath);
 	}
 
-	self->control.view.needsLayout = true;
-}
+	$(self->reusableItems, removeAllObjects);
 
-/**
- * @brief ArrayEnumerator for all item selection.
- */
-static void selectAll_enumerate(const Array *array, ident obj, ident data) {
-	$((CollectionItemView *) obj, setSelected, true);
+	$(self->contentView, addSubviews, (Array *) self->items);
+
+	const size_t words = selectionWords(numberOfItems);
+
+	free(self->selection);
+	self->selection = calloc(words + 1, sizeof(uint64_t));
+	assert(self->selection);
+
+	free(self->rubberBandSelection);
+	self->rubberBandSelection = calloc(words + 1, sizeof(uint64_t));
+	assert(self->rubberBandSelection);
+
+	self->selectionAnchor = -1;
+	self->isRubberBanding = false;
+
+	$(self->layout, invalidateLayout);
+
+	self->control.view.needsLayout = true;
 }
 
 /**
@@ -403,7 +672,7 @@ static void selectAll_enumerate(const Array *array, ident obj, ident data) {
  * @memberof CollectionView
  */
 static void selectAll(CollectionView *self) {
-	$((Array *) self->items, enumerateObjects, selectAll_enumerate, NULL);
+	setItemsSelected(self, 0, self->items->array.count, true);
 }
 
 /**
@@ -414,22 +683,79 @@ static Array *selectionIndexPaths(const CollectionView *self) {
 
 	MutableArray *array = $$(MutableArray, array);
 
-	const Array *items = (Array *) self->items;
-	for (size_t i = 0; i < items->count; i++) {
+	const size_t words = selectionWords(self->items->array.count);
+	for (size_t i = 0; i < words; i++) {
 
-		const CollectionItemView *item = $(items, objectAtIndex, i);
-		if (item->isSelected) {
+		uint64_t word = self->selection[i];
+		while (word) {
 
-			IndexPath *indexPath = $(self, indexPathForItem, item);
-			$(array, addObject, indexPath);
+			const size_t index = i * SELECTION_WORD_BITS + __builtin_ctzll(word);
+			$(array, addObject, indexPathForIndex(self, index));
 
-			release(indexPath);
+			word &= word - 1;
 		}
 	}
 
 	return (Array *) array;
 }
 
+/**
+ * @fn size_t CollectionView::selectionRanges(const CollectionView *self, Range *ranges, size_t count)
+ * @memberof CollectionView
+ */
+static size_t selectionRanges(const CollectionView *self, Range *ranges, size_t count) {
+
+	const size_t numberOfItems = self->items->array.count;
+	const size_t words = selectionWords(numberOfItems);
+
+	size_t total = 0;
+	ssize_t start = -1;
+
+	for (size_t i = 0; i < words; i++) {
+
+		const uint64_t word = self->selection[i];
+
+		if ((start == -1 && word == 0) || (start > -1 && word == ~0ULL)) {
+			continue;
+		}
+
+		for (size_t bit = 0; bit < SELECTION_WORD_BITS; ) {
+
+			const uint64_t rest = (start == -1 ? word : ~word) >> bit;
+			if (rest == 0) {
+				break;
+			}
+
+			bit += __builtin_ctzll(rest);
+
+			if (start == -1) {
+				start = i * SELECTION_WORD_BITS + bit;
+			} else {
+				if (total < count) {
+					ranges[total] = (Range) {
+						.location = start,
+						.length = i * SELECTION_WORD_BITS + bit - start
+					};
+				}
+				total++;
+				start = -1;
+			}
+		}
+	}
+
+	if (start > -1) {
+		if (total < count) {
+			ranges[total] = (Range) {
+				.location = start,
+				.length = numberOfItems - start
+			};
+		}
+		total++;
+	}
+
+	return total;
+}
+
 /**
  * @fn void CollectionView::selectItemAtIndexPath(CollectionView *self, const IndexPath *indexPath)
  * @memberof CollectionView
@@ -437,10 +763,8 @@ static Array *selectionIndexPaths(const CollectionView *self) {
 static void selectItemAtIndexPath(CollectionView *self, const IndexPath *indexPath) {
 
 	if (indexPath) {
-		CollectionItemView *item = $(self, itemAtIndexPath, indexPath);
-		if (item) {
-			$(item, setSelected, true);
-		}
+		const size_t index = $(indexPath, indexAtPosition, 0);
+		setItemsSelected(self, index, index + 1, true);
 	}
 }
 
@@ -462,6 +786,67 @@ static void selectItemsAtIndexPaths(CollectionView *self, const Array *indexPath
 	}
 }
 
+/**
+ * @fn void CollectionView::selectItemsInRange(CollectionView *self, const Range range)
+ * @memberof CollectionView
+ */
+static void selectItemsInRange(CollectionView *self, const Range range) {
+
+	const size_t start = max(range.location, 0);
+	const size_t end = (size_t) max(range.location + (ssize_t) range.length, 0);
+
+	setItemsSelected(self, start, end, true);
+}
+
+/**
+ * @fn void CollectionView::setLayout(CollectionView *self, CollectionViewLayout *layout)
+ * @memberof CollectionView
+ */
+static void setLayout(CollectionView *self, CollectionViewLayout *layout) {
+
+	assert(layout);
+
+	if (layout != self->layout) {
+
+		release(self->layout);
+		self->layout = retain(layout);
+
+		$(self->layout, invalidateLayout);
+
+		self->control.view.needsLayout = true;
+	}
+}
+
+/**
+ * @fn SDL_Size CollectionView::sizeForItemAtIndex(const CollectionView *self, size_t index)
+ * @memberof CollectionView
+ */
+static SDL_Size sizeForItemAtIndex(const CollectionView *self, size_t index) {
+
+	if (self->delegate.sizeForItemAtIndex) {
+		return self->delegate.sizeForItemAtIndex(self, index);
+	}
+
+	return self->itemSize;
+}
+
+/**
+ * @fn void CollectionView::setThumbnailLoader(CollectionView *self, ThumbnailLoader *thumbnailLoader)
+ * @memberof CollectionView
+ */
+static void setThumbnailLoader(CollectionView *self, ThumbnailLoader *thumbnailLoader) {
+
+	if (thumbnailLoader != self->thumbnailLoader) {
+
+		if (self->thumbnailLoader) {
+			$(self->thumbnailLoader, cancelAll);
+			release(self->thumbnailLoader);
+		}
+
+		self->thumbnailLoader = thumbnailLoader ? retain(thumbnailLoader) : NULL;
+	}
+}
+
 #pragma mark - Class lifecycle
 
 /**
@@ -472,6 +857,7 @@ static void initialize(Class *clazz) {
 	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
 
 	((ViewInterface *) clazz->def->interface)->awakeWithDictionary = awakeWithDictionary;
+	((ViewInterface *) clazz->def->interface)->didLayoutSubviews = didLayoutSubviews;
 	((ViewInterface *) clazz->def->interface)->init = init;
 	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
 
@@ -480,15 +866,23 @@ static void initialize(Class *clazz) {
 	((CollectionViewInterface *) clazz->def->interface)->deselectAll = deselectAll;
 	((CollectionViewInterface *) clazz->def->interface)->deselectItemAtIndexPath = deselectItemAtIndexPath;
 	((CollectionViewInterface *) clazz->def->interface)->deselectItemsAtIndexPaths = deselectItemsAtIndexPaths;
+	((CollectionViewInterface *) clazz->def->interface)->deselectItemsInRange = deselectItemsInRange;
+	((CollectionViewInterface *) clazz->def->interface)->dequeueReusableItem = dequeueReusableItem;
 	((CollectionViewInterface *) clazz->def->interface)->indexPathForItem = indexPathForItem;
 	((CollectionViewInterface *) clazz->def->interface)->indexPathForItemAtPoint = indexPathForItemAtPoint;
 	((CollectionViewInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
 	((CollectionViewInterface *) clazz->def->interface)->itemAtIndexPath = itemAtIndexPath;
+	((CollectionViewInterface *) clazz->def->interface)->itemIndexAtPoint = itemIndexAtPoint;
 	((CollectionViewInterface *) clazz->def->interface)->reloadData = reloadData;
 	((CollectionViewInterface *) clazz->def->interface)->selectAll = selectAll;
 	((CollectionViewInterface *) clazz->def->interface)->selectionIndexPaths = selectionIndexPaths;
+	((CollectionViewInterface *) clazz->def->interface)->selectionRanges = selectionRanges;
 	((CollectionViewInterface *) clazz->def->interface)->selectItemAtIndexPath = selectItemAtIndexPath;
 	((CollectionViewInterface *) clazz->def->interface)->selectItemsAtIndexPaths = selectItemsAtIndexPaths;
+	((CollectionViewInterface *) clazz->def->interface)->selectItemsInRange = selectItemsInRange;
+	((CollectionViewInterface *) clazz->def->interface)->setLayout = setLayout;
+	((CollectionViewInterface *) clazz->def->interface)->setThumbnailLoader = setThumbnailLoader;
+	((CollectionViewInterface *) clazz->def->interface)->sizeForItemAtIndex = sizeForItemAtIndex;
 }
 
 /**
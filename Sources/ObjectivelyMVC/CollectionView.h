@@ -27,7 +27,9 @@
 
 #include <ObjectivelyMVC/Control.h>
 #include <ObjectivelyMVC/CollectionItemView.h>
+#include <ObjectivelyMVC/CollectionViewLayout.h>
 #include <ObjectivelyMVC/ScrollView.h>
+#include <ObjectivelyMVC/ThumbnailLoader.h>
 
 /**
  * @file
@@ -93,13 +95,34 @@ struct CollectionViewDelegate {
 	 */
 	void (*didModifySelection)(CollectionView *collectionView, const Array *selectionIndexPaths);
 
+	/**
+	 * @brief Called by the CollectionView when items are selected or deselected.
+	 * @param collectionView The CollectionView.
+	 * @param ranges The current selection, as sorted, disjoint ranges of item indexes.
+	 * @param count The count of `ranges`.
+	 * @remarks This function is optional. Unlike `didModifySelection`, it allocates nothing, and
+	 * is preferred for large collections.
+	 */
+	void (*didModifySelectionRanges)(CollectionView *collectionView, const Range *ranges, size_t count);
+
 	/**
 	 * @brief Called by the CollectionView to instantiate items.
 	 * @param collectionView The CollectionView.
 	 * @param indexPath The index path.
 	 * @return The item for the index path.
+	 * @remarks Implementations should prefer CollectionView::dequeueReusableItem to allocating a
+	 * new item.
 	 */
 	CollectionItemView *(*itemForObjectAtIndexPath)(const CollectionView *collectionView, const IndexPath *indexPath);
+
+	/**
+	 * @brief Called by the CollectionView's layout to measure items of varying sizes.
+	 * @param collectionView The CollectionView.
+	 * @param index The index of the item.
+	 * @return The size of the item.
+	 * @remarks This function is optional. If not implemented, all items are of `itemSize`.
+	 */
+	SDL_Size (*sizeForItemAtIndex)(const CollectionView *collectionView, size_t index);
 };
 
 #define DEAFULT_COLLECTION_VIEW_PADDING 10
@@ -145,6 +168,20 @@ struct CollectionView {
 	 */
 	CollectionViewDelegate delegate;
 
+	/**
+	 * @brief The IndexPaths of item indexes, allocated once and shared.
+	 * @remarks IndexPaths are immutable, so reloadData, selection changes and hit testing reuse these
+	 * rather than allocating new ones.
+	 * @private
+	 */
+	MutableArray *indexPaths;
+
+	/**
+	 * @brief True while a left mouse button press is tracked for rubber-band selection.
+	 * @private
+	 */
+	_Bool isRubberBanding;
+
 	/**
 	 * @brief The items.
 	 */
@@ -160,10 +197,73 @@ struct CollectionView {
 	 */
 	SDL_Size itemSpacing;
 
+	/**
+	 * @brief The layout, which computes and caches the item frames.
+	 */
+	CollectionViewLayout *layout;
+
+	/**
+	 * @brief The rubber-band, in content view coordinates, or a width of `-1` before the mouse moves.
+	 * @private
+	 */
+	SDL_Rect rubberBand;
+
+	/**
+	 * @brief The point at which the rubber-band began, in content view coordinates.
+	 * @private
+	 */
+	SDL_Point rubberBandOrigin;
+
+	/**
+	 * @brief The selection bitset at the beginning of the rubber-band.
+	 * @private
+	 */
+	uint64_t *rubberBandSelection;
+
+	/**
+	 * @brief Recycled CollectionItemViews, available for reuse.
+	 * @remarks This is populated with the previous items at the start of each reload, and items
+	 * that the reload does not dequeue are released at its end.
+	 * @private
+	 */
+	MutableArray *reusableItems;
+
 	/**
 	 * @brief The scroll view.
 	 */
 	ScrollView *scrollView;
+
+	/**
+	 * @brief The selection bitset, with one bit per item.
+	 * @remarks The selection is owned by the CollectionView; items' `isSelected` mirrors it.
+	 * @private
+	 */
+	uint64_t *selection;
+
+	/**
+	 * @brief The index of the item from which Shift-selection extends, or `-1`.
+	 * @private
+	 */
+	ssize_t selectionAnchor;
+
+	/**
+	 * @brief The buffer backing `didModifySelectionRanges`, reused across notifications.
+	 * @private
+	 */
+	Range *selectionRangesBuffer;
+
+	/**
+	 * @brief The capacity of `selectionRangesBuffer`.
+	 * @private
+	 */
+	size_t selectionRangesCapacity;
+
+	/**
+	 * @brief The ThumbnailLoader for item images, or `NULL`.
+	 * @remarks The CollectionView dispatches the loader as it lays out, and cancels its requests
+	 * when reloading data.
+	 */
+	ThumbnailLoader *thumbnailLoader;
 };
 
 /**
@@ -202,6 +302,27 @@ struct CollectionViewInterface {
 	 */
 	void (*deselectItemsAtIndexPaths)(CollectionView *self, const Array *indexPaths);
 
+	/**
+	 * @fn void CollectionView::deselectItemsInRange(CollectionView *self, const Range range)
+	 * @brief Deselects the items at the indexes in the given range.
+	 * @param self The CollectionView.
+	 * @param range The range of item indexes to deselect.
+	 * @memberof CollectionView
+	 */
+	void (*deselectItemsInRange)(CollectionView *self, const Range range);
+
+	/**
+	 * @fn CollectionItemView *CollectionView::dequeueReusableItem(const CollectionView *self)
+	 * @brief Dequeues an item recycled by CollectionView::reloadData.
+	 * @param self The CollectionView.
+	 * @return A retained, reset CollectionItemView, or `NULL` if none are available.
+	 * @remarks Call this from CollectionViewDelegate::itemForObjectAtIndexPath, and allocate a new
+	 * item only if it returns `NULL`. Items are available only while CollectionView::reloadData is
+	 * in progress.
+	 * @memberof CollectionView
+	 */
+	CollectionItemView *(*dequeueReusableItem)(const CollectionView *self);
+
 	/**
 	 * @fn CollectionView *CollectionView::init(CollectionView *self, const SDL_Rect *frame, ControlStyle style)
 	 * @brief Initializes this CollectionView with the specified frame and style.
@@ -240,6 +361,16 @@ struct CollectionViewInterface {
 	 */
 	CollectionItemView *(*itemAtIndexPath)(const CollectionView *self, const IndexPath *indexPath);
 
+	/**
+	 * @fn ssize_t CollectionView::itemIndexAtPoint(const CollectionView *self, const SDL_Point *point)
+	 * @param self The CollectionView.
+	 * @param point A point in window coordinate space.
+	 * @return The index of the item at the specified point, or `-1`.
+	 * @remarks Unlike `indexPathForItemAtPoint`, this method allocates nothing.
+	 * @memberof CollectionView
+	 */
+	ssize_t (*itemIndexAtPoint)(const CollectionView *self, const SDL_Point *point);
+
 	/**
 	 * @fn void CollectionView::reloadData(CollectionView *self)
 	 * @brief Reloads this CollectionView's visible items.
@@ -266,6 +397,17 @@ struct CollectionViewInterface {
 	 */
 	Array *(*selectionIndexPaths)(const CollectionView *self);
 
+	/**
+	 * @fn size_t CollectionView::selectionRanges(const CollectionView *self, Range *ranges, size_t count)
+	 * @brief Writes the current selection as sorted, disjoint ranges of item indexes.
+	 * @param self The CollectionView.
+	 * @param ranges The output buffer, which may be `NULL`.
+	 * @param count The capacity of `ranges`.
+	 * @return The total count of selected ranges, which may exceed `count`.
+	 * @memberof CollectionView
+	 */
+	size_t (*selectionRanges)(const CollectionView *self, Range *ranges, size_t count);
+
 	/**
 	 * @fn void CollectionView::selectItemAtIndexPath(CollectionView *self, const IndexPath *indexPath)
 	 * @brief Selects the item at the given index path.
@@ -283,6 +425,42 @@ struct CollectionViewInterface {
 	 * @memberof CollectionView
 	 */
 	void (*selectItemsAtIndexPaths)(CollectionView *self, const Array *indexPaths);
+
+	/**
+	 * @fn void CollectionView::selectItemsInRange(CollectionView *self, const Range range)
+	 * @brief Selects the items at the indexes in the given range.
+	 * @param self The CollectionView.
+	 * @param range The range of item indexes to select.
+	 * @memberof CollectionView
+	 */
+	void (*selectItemsInRange)(CollectionView *self, const Range range);
+
+	/**
+	 * @fn void CollectionView::setLayout(CollectionView *self, CollectionViewLayout *layout)
+	 * @brief Sets the layout of this CollectionView.
+	 * @param self The CollectionView.
+	 * @param layout The CollectionViewLayout.
+	 * @memberof CollectionView
+	 */
+	void (*setLayout)(CollectionView *self, CollectionViewLayout *layout);
+
+	/**
+	 * @fn SDL_Size CollectionView::sizeForItemAtIndex(const CollectionView *self, size_t index)
+	 * @param self The CollectionView.
+	 * @param index The index of the item.
+	 * @return The size of the item, as provided by the delegate, or `itemSize`.
+	 * @memberof CollectionView
+	 */
+	SDL_Size (*sizeForItemAtIndex)(const CollectionView *self, size_t index);
+
+	/**
+	 * @fn void CollectionView::setThumbnailLoader(CollectionView *self, ThumbnailLoader *thumbnailLoader)
+	 * @brief Sets the ThumbnailLoader for item images.
+	 * @param self The CollectionView.
+	 * @param thumbnailLoader The ThumbnailLoader, or `NULL`.
+	 * @memberof CollectionView
+	 */
+	void (*setThumbnailLoader)(CollectionView *self, ThumbnailLoader *thumbnailLoader);
 };
 
 /**
@@ -0,0 +1,131 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <ObjectivelyMVC/CollectionView.h>
+#include <ObjectivelyMVC/CollectionViewFlowLayout.h>
+
+#define _Class _CollectionViewFlowLayout
+
+#pragma mark - CollectionViewLayout
+
+/**
+ * @see CollectionViewLayout::layoutItems(CollectionViewLayout *, const CollectionView *, size_t)
+ */
+static void layoutItems(CollectionViewLayout *self, const CollectionView *collectionView, size_t index) {
+
+	const _Bool vertical = collectionView->axis == CollectionViewAxisVertical;
+
+	const int limit = vertical ? self->state.size.w : self->state.size.h;
+	const int spacing = vertical ? collectionView->itemSpacing.w : collectionView->itemSpacing.h;
+	const int lineSpacing = vertical ? collectionView->itemSpacing.h : collectionView->itemSpacing.w;
+
+	size_t start = index;
+	int along = 0, across = 0, thickness = 0;
+
+	if (index > 0) {
+		const SDL_Rect *previous = self->attributes + index - 1;
+
+		across = vertical ? previous->y : previous->x;
+
+		start = index - 1;
+		while (start > 0) {
+			const SDL_Rect *frame = self->attributes + start - 1;
+			if ((vertical ? frame->y : frame->x) != across) {
+				break;
+			}
+			start--;
+		}
+	}
+
+	for (size_t i = start; i < self->count; i++) {
+
+		SDL_Rect *frame = self->attributes + i;
+
+		SDL_Size size;
+		if (i < index) {
+			size = MakeSize(frame->w, frame->h);
+		} else {
+			size = $(collectionView, sizeForItemAtIndex, i);
+		}
+
+		const int length = vertical ? size.w : size.h;
+
+		if (along > 0 && along + length > limit) {
+			across += thickness + lineSpacing;
+			along = thickness = 0;
+		}
+
+		if (vertical) {
+			*frame = MakeRect(along, across, size.w, size.h);
+		} else {
+			*frame = MakeRect(across, along, size.w, size.h);
+		}
+
+		along += length + spacing;
+		thickness = max(thickness, vertical ? size.h : size.w);
+	}
+}
+
+#pragma mark - CollectionViewFlowLayout
+
+/**
+ * @fn CollectionViewFlowLayout *CollectionViewFlowLayout::init(CollectionViewFlowLayout *self)
+ * @memberof CollectionViewFlowLayout
+ */
+static CollectionViewFlowLayout *init(CollectionViewFlowLayout *self) {
+	return (CollectionViewFlowLayout *) super(CollectionViewLayout, self, init);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((CollectionViewLayoutInterface *) clazz->def->interface)->layoutItems = layoutItems;
+
+	((CollectionViewFlowLayoutInterface *) clazz->def->interface)->init = init;
+}
+
+/**
+ * @fn Class *CollectionViewFlowLayout::_CollectionViewFlowLayout(void)
+ * @memberof CollectionViewFlowLayout
+ */
+Class *_CollectionViewFlowLayout(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "CollectionViewFlowLayout";
+		clazz.superclass = _CollectionViewLayout();
+		clazz.instanceSize = sizeof(CollectionViewFlowLayout);
+		clazz.interfaceOffset = offsetof(CollectionViewFlowLayout, interface);
+		clazz.interfaceSize = sizeof(CollectionViewFlowLayoutInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,83 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <ObjectivelyMVC/CollectionViewLayout.h>
+
+/**
+ * @file
+ * @brief The CollectionViewFlowLayout type.
+ */
+
+typedef struct CollectionViewFlowLayout CollectionViewFlowLayout;
+typedef struct CollectionViewFlowLayoutInterface CollectionViewFlowLayoutInterface;
+
+/**
+ * @brief CollectionViewFlowLayouts arrange items of varying sizes in lines.
+ * @details Items are placed along the line, which wraps when full, and each line is as thick as
+ * its thickest item. Item sizes are provided by the CollectionViewDelegate.
+ * @extends CollectionViewLayout
+ * @ingroup CollectionViews
+ */
+struct CollectionViewFlowLayout {
+
+	/**
+	 * @brief The superclass.
+	 */
+	CollectionViewLayout collectionViewLayout;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	CollectionViewFlowLayoutInterface *interface;
+};
+
+/**
+ * @brief The CollectionViewFlowLayout interface.
+ */
+struct CollectionViewFlowLayoutInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	CollectionViewLayoutInterface collectionViewLayoutInterface;
+
+	/**
+	 * @fn CollectionViewFlowLayout *CollectionViewFlowLayout::init(CollectionViewFlowLayout *self)
+	 * @brief Initializes this CollectionViewFlowLayout.
+	 * @param self The CollectionViewFlowLayout.
+	 * @return The initialized CollectionViewFlowLayout, or `NULL` on error.
+	 * @memberof CollectionViewFlowLayout
+	 */
+	CollectionViewFlowLayout *(*init)(CollectionViewFlowLayout *self);
+};
+
+/**
+ * @fn Class *CollectionViewFlowLayout::_CollectionViewFlowLayout(void)
+ * @brief The CollectionViewFlowLayout archetype.
+ * @return The CollectionViewFlowLayout Class.
+ * @memberof CollectionViewFlowLayout
+ */
+OBJECTIVELYMVC_EXPORT Class *_CollectionViewFlowLayout(void);
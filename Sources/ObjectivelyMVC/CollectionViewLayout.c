@@ -0,0 +1,320 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ObjectivelyMVC/CollectionView.h>
+#include <ObjectivelyMVC/CollectionViewLayout.h>
+
+/**
+ * @brief An entry in the interval index of a CollectionViewLayout.
+ */
+struct CollectionViewLayoutInterval {
+
+	/**
+	 * @brief The origin of the item on the scrolling axis.
+	 */
+	int origin;
+
+	/**
+	 * @brief The index of the item.
+	 */
+	size_t index;
+};
+
+#define _Class _CollectionViewLayout
+
+/**
+ * @brief Comparator for sorting intervals by origin.
+ */
+static int compareIntervals(const void *a, const void *b) {
+
+	const CollectionViewLayoutInterval *i1 = a, *i2 = b;
+
+	if (i1->origin == i2->origin) {
+		return i1->index < i2->index ? -1 : i1->index > i2->index;
+	}
+
+	return i1->origin < i2->origin ? -1 : 1;
+}
+
+/**
+ * @brief Rebuilds the interval index and the content size from the item frames.
+ */
+static void buildIntervals(CollectionViewLayout *self, CollectionViewAxis axis) {
+
+	self->contentSize = MakeSize(0, 0);
+	self->maxExtent = 0;
+
+	_Bool sorted = true;
+
+	for (size_t i = 0; i < self->count; i++) {
+
+		const SDL_Rect *frame = self->attributes + i;
+
+		self->contentSize.w = max(self->contentSize.w, frame->x + frame->w);
+		self->contentSize.h = max(self->contentSize.h, frame->y + frame->h);
+
+		CollectionViewLayoutInterval *interval = self->intervals + i;
+
+		switch (axis) {
+			case CollectionViewAxisVertical:
+				interval->origin = frame->y;
+				self->maxExtent = max(self->maxExtent, frame->h);
+				break;
+			case CollectionViewAxisHorizontal:
+				interval->origin = frame->x;
+				self->maxExtent = max(self->maxExtent, frame->w);
+				break;
+		}
+
+		interval->index = i;
+
+		if (i && interval->origin < interval[-1].origin) {
+			sorted = false;
+		}
+	}
+
+	if (sorted == false) {
+		qsort(self->intervals, self->count, sizeof(CollectionViewLayoutInterval), compareIntervals);
+	}
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	CollectionViewLayout *this = (CollectionViewLayout *) self;
+
+	free(this->attributes);
+	free(this->intervals);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - CollectionViewLayout
+
+/**
+ * @fn void CollectionViewLayout::enumerateItemsInRect(const CollectionViewLayout *self, const SDL_Rect *rect, CollectionViewLayoutEnumerator enumerator, ident data)
+ * @memberof CollectionViewLayout
+ */
+static void enumerateItemsInRect(const CollectionViewLayout *self, const SDL_Rect *rect, CollectionViewLayoutEnumerator enumerator, ident data) {
+
+	assert(enumerator);
+
+	if (self->count == 0) {
+		return;
+	}
+
+	const int x1 = rect->x, x2 = rect->x + max(rect->w, 1);
+	const int y1 = rect->y, y2 = rect->y + max(rect->h, 1);
+
+	const _Bool vertical = self->state.axis == CollectionViewAxisVertical;
+
+	const int start = (vertical ? y1 : x1) - self->maxExtent;
+	const int end = vertical ? y2 : x2;
+
+	size_t low = 0, high = self->count;
+	while (low < high) {
+		const size_t mid = (low + high) / 2;
+		if (self->intervals[mid].origin < start) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (size_t i = low; i < self->count && self->intervals[i].origin < end; i++) {
+
+		const size_t index = self->intervals[i].index;
+		const SDL_Rect *frame = self->attributes + index;
+
+		if (frame->x < x2 && frame->x + frame->w > x1 && frame->y < y2 && frame->y + frame->h > y1) {
+			enumerator(self, index, data);
+		}
+	}
+}
+
+/**
+ * @fn CollectionViewLayout *CollectionViewLayout::init(CollectionViewLayout *self)
+ * @memberof CollectionViewLayout
+ */
+static CollectionViewLayout *init(CollectionViewLayout *self) {
+	return (CollectionViewLayout *) super(Object, self, init);
+}
+
+/**
+ * @fn void CollectionViewLayout::invalidateLayout(CollectionViewLayout *self)
+ * @memberof CollectionViewLayout
+ */
+static void invalidateLayout(CollectionViewLayout *self) {
+	self->validCount = 0;
+}
+
+/**
+ * @fn void CollectionViewLayout::invalidateLayoutFromIndex(CollectionViewLayout *self, size_t index)
+ * @memberof CollectionViewLayout
+ */
+static void invalidateLayoutFromIndex(CollectionViewLayout *self, size_t index) {
+	self->validCount = min(self->validCount, index);
+}
+
+/**
+ * @fn void CollectionViewLayout::layoutItems(CollectionViewLayout *self, const CollectionView *collectionView, size_t index)
+ * @memberof CollectionViewLayout
+ */
+static void layoutItems(CollectionViewLayout *self, const CollectionView *collectionView, size_t index) {
+
+	const SDL_Size itemSize = collectionView->itemSize;
+
+	const int itemWidth = itemSize.w + collectionView->itemSpacing.w;
+	const int itemHeight = itemSize.h + collectionView->itemSpacing.h;
+
+	int lines;
+	switch (collectionView->axis) {
+		case CollectionViewAxisVertical:
+			lines = max(1, (self->state.size.w + collectionView->itemSpacing.w) / max(itemWidth, 1));
+			break;
+		case CollectionViewAxisHorizontal:
+			lines = max(1, (self->state.size.h + collectionView->itemSpacing.h) / max(itemHeight, 1));
+			break;
+	}
+
+	for (size_t i = index; i < self->count; i++) {
+
+		SDL_Rect *frame = self->attributes + i;
+
+		switch (collectionView->axis) {
+			case CollectionViewAxisVertical:
+				frame->x = (i % lines) * itemWidth;
+				frame->y = (i / lines) * itemHeight;
+				break;
+			case CollectionViewAxisHorizontal:
+				frame->x = (i / lines) * itemWidth;
+				frame->y = (i % lines) * itemHeight;
+				break;
+		}
+
+		frame->w = itemSize.w;
+		frame->h = itemSize.h;
+	}
+}
+
+/**
+ * @fn void CollectionViewLayout::prepareLayout(CollectionViewLayout *self, const CollectionView *collectionView)
+ * @memberof CollectionViewLayout
+ */
+static void prepareLayout(CollectionViewLayout *self, const CollectionView *collectionView) {
+
+	const SDL_Rect bounds = $((View *) collectionView, bounds);
+	const ViewPadding padding = collectionView->contentView->padding;
+
+	const SDL_Size size = MakeSize(bounds.w - padding.left - padding.right, bounds.h - padding.top - padding.bottom);
+
+	if (self->state.axis != (int) collectionView->axis ||
+		memcmp(&self->state.itemSize, &collectionView->itemSize, sizeof(SDL_Size)) ||
+		memcmp(&self->state.itemSpacing, &collectionView->itemSpacing, sizeof(SDL_Size)) ||
+		(collectionView->axis == CollectionViewAxisVertical && self->state.size.w != size.w) ||
+		(collectionView->axis == CollectionViewAxisHorizontal && self->state.size.h != size.h)) {
+
+		self->state.axis = collectionView->axis;
+		self->state.itemSize = collectionView->itemSize;
+		self->state.itemSpacing = collectionView->itemSpacing;
+
+		self->validCount = 0;
+	}
+
+	self->state.size = size;
+
+	const size_t count = collectionView->items->array.count;
+
+	_Bool changed = false;
+	if (count != self->count) {
+
+		self->attributes = realloc(self->attributes, (count + 1) * sizeof(SDL_Rect));
+		assert(self->attributes);
+
+		self->intervals = realloc(self->intervals, (count + 1) * sizeof(CollectionViewLayoutInterval));
+		assert(self->intervals);
+
+		self->count = count;
+		self->validCount = min(self->validCount, count);
+
+		changed = true;
+	}
+
+	if (self->validCount < self->count) {
+		$(self, layoutItems, collectionView, self->validCount);
+
+		self->validCount = self->count;
+		changed = true;
+	}
+
+	if (changed) {
+		buildIntervals(self, collectionView->axis);
+	}
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
+
+	((CollectionViewLayoutInterface *) clazz->def->interface)->enumerateItemsInRect = enumerateItemsInRect;
+	((CollectionViewLayoutInterface *) clazz->def->interface)->init = init;
+	((CollectionViewLayoutInterface *) clazz->def->interface)->invalidateLayout = invalidateLayout;
+	((CollectionViewLayoutInterface *) clazz->def->interface)->invalidateLayoutFromIndex = invalidateLayoutFromIndex;
+	((CollectionViewLayoutInterface *) clazz->def->interface)->layoutItems = layoutItems;
+	((CollectionViewLayoutInterface *) clazz->def->interface)->prepareLayout = prepareLayout;
+}
+
+/**
+ * @fn Class *CollectionViewLayout::_CollectionViewLayout(void)
+ * @memberof CollectionViewLayout
+ */
+Class *_CollectionViewLayout(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "CollectionViewLayout";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(CollectionViewLayout);
+		clazz.interfaceOffset = offsetof(CollectionViewLayout, interface);
+		clazz.interfaceSize = sizeof(CollectionViewLayoutInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,196 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Object.h>
+
+#include <ObjectivelyMVC/Types.h>
+
+/**
+ * @file
+ * @brief The CollectionViewLayout type.
+ */
+
+typedef struct CollectionView CollectionView;
+
+typedef struct CollectionViewLayoutInterval CollectionViewLayoutInterval;
+
+typedef struct CollectionViewLayout CollectionViewLayout;
+typedef struct CollectionViewLayoutInterface CollectionViewLayoutInterface;
+
+/**
+ * @brief A function type for CollectionViewLayout item enumeration.
+ * @param layout The CollectionViewLayout.
+ * @param index The index of the item.
+ * @param data User data.
+ */
+typedef void (*CollectionViewLayoutEnumerator)(const CollectionViewLayout *layout, size_t index, ident data);
+
+/**
+ * @brief CollectionViewLayouts compute and cache the frames of a CollectionView's items.
+ * @details The base CollectionViewLayout arranges items of the CollectionView's `itemSize` in a
+ * grid. Subclasses override `layoutItems` to arrange items otherwise.
+ * @extends Object
+ * @ingroup CollectionViews
+ */
+struct CollectionViewLayout {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Object object;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	CollectionViewLayoutInterface *interface;
+
+	/**
+	 * @brief The item frames, in the content View's bounds.
+	 */
+	SDL_Rect *attributes;
+
+	/**
+	 * @brief The size of the content, which contains all items.
+	 */
+	SDL_Size contentSize;
+
+	/**
+	 * @brief The count of `attributes`.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The items, sorted by their origin on the scrolling axis, for visible rect queries.
+	 * @private
+	 */
+	CollectionViewLayoutInterval *intervals;
+
+	/**
+	 * @brief The largest item extent on the scrolling axis.
+	 * @private
+	 */
+	int maxExtent;
+
+	/**
+	 * @brief The CollectionView properties for which `attributes` were computed.
+	 * @private
+	 */
+	struct {
+		int axis;
+		SDL_Size itemSize;
+		SDL_Size itemSpacing;
+		SDL_Size size;
+	} state;
+
+	/**
+	 * @brief The count of leading `attributes` that are valid.
+	 * @private
+	 */
+	size_t validCount;
+};
+
+/**
+ * @brief The CollectionViewLayout interface.
+ */
+struct CollectionViewLayoutInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @fn void CollectionViewLayout::enumerateItemsInRect(const CollectionViewLayout *self, const SDL_Rect *rect, CollectionViewLayoutEnumerator enumerator, ident data)
+	 * @brief Enumerates the items intersecting the given rectangle.
+	 * @param self The CollectionViewLayout.
+	 * @param rect A rectangle in the content View's bounds.
+	 * @param enumerator The enumerator.
+	 * @param data User data.
+	 * @remarks Items are found through an interval index, in `O(log n + k)`.
+	 * @memberof CollectionViewLayout
+	 */
+	void (*enumerateItemsInRect)(const CollectionViewLayout *self, const SDL_Rect *rect, CollectionViewLayoutEnumerator enumerator, ident data);
+
+	/**
+	 * @fn CollectionViewLayout *CollectionViewLayout::init(CollectionViewLayout *self)
+	 * @brief Initializes this CollectionViewLayout.
+	 * @param self The CollectionViewLayout.
+	 * @return The initialized CollectionViewLayout, or `NULL` on error.
+	 * @memberof CollectionViewLayout
+	 */
+	CollectionViewLayout *(*init)(CollectionViewLayout *self);
+
+	/**
+	 * @fn void CollectionViewLayout::invalidateLayout(CollectionViewLayout *self)
+	 * @brief Invalidates the frames of all items.
+	 * @param self The CollectionViewLayout.
+	 * @memberof CollectionViewLayout
+	 */
+	void (*invalidateLayout)(CollectionViewLayout *self);
+
+	/**
+	 * @fn void CollectionViewLayout::invalidateLayoutFromIndex(CollectionViewLayout *self, size_t index)
+	 * @brief Invalidates the frames of the items from `index` onward.
+	 * @param self The CollectionViewLayout.
+	 * @param index The index of the first changed item.
+	 * @remarks Call this method when the size of an item changes, and then flag the CollectionView
+	 * as needing layout. Items preceding `index` are not measured again.
+	 * @memberof CollectionViewLayout
+	 */
+	void (*invalidateLayoutFromIndex)(CollectionViewLayout *self, size_t index);
+
+	/**
+	 * @fn void CollectionViewLayout::layoutItems(CollectionViewLayout *self, const CollectionView *collectionView, size_t index)
+	 * @brief Computes the frames of the items from `index` onward.
+	 * @param self The CollectionViewLayout.
+	 * @param collectionView The CollectionView.
+	 * @param index The index of the first item to lay out.
+	 * @remarks Subclasses override this method to arrange items. The frames of the items preceding
+	 * `index` are valid, and may be used to resume the arrangement.
+	 * @protected
+	 * @memberof CollectionViewLayout
+	 */
+	void (*layoutItems)(CollectionViewLayout *self, const CollectionView *collectionView, size_t index);
+
+	/**
+	 * @fn void CollectionViewLayout::prepareLayout(CollectionViewLayout *self, const CollectionView *collectionView)
+	 * @brief Computes the frames of any invalid items, and updates the content size.
+	 * @param self The CollectionViewLayout.
+	 * @param collectionView The CollectionView.
+	 * @remarks Changes to the CollectionView's axis, item size, item spacing or width (height, for
+	 * horizontal CollectionViews) invalidate all items.
+	 * @memberof CollectionViewLayout
+	 */
+	void (*prepareLayout)(CollectionViewLayout *self, const CollectionView *collectionView);
+};
+
+/**
+ * @fn Class *CollectionViewLayout::_CollectionViewLayout(void)
+ * @brief The CollectionViewLayout archetype.
+ * @return The CollectionViewLayout Class.
+ * @memberof CollectionViewLayout
+ */
+OBJECTIVELYMVC_EXPORT Class *_CollectionViewLayout(void);
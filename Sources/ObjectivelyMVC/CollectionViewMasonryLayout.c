@@ -0,0 +1,134 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <ObjectivelyMVC/CollectionView.h>
+#include <ObjectivelyMVC/CollectionViewMasonryLayout.h>
+
+#define _Class _CollectionViewMasonryLayout
+
+#pragma mark - CollectionViewLayout
+
+/**
+ * @see CollectionViewLayout::layoutItems(CollectionViewLayout *, const CollectionView *, size_t)
+ */
+static void layoutItems(CollectionViewLayout *self, const CollectionView *collectionView, size_t index) {
+
+	const _Bool vertical = collectionView->axis == CollectionViewAxisVertical;
+
+	const int limit = vertical ? self->state.size.w : self->state.size.h;
+	const int laneSize = vertical ? collectionView->itemSize.w : collectionView->itemSize.h;
+	const int spacing = vertical ? collectionView->itemSpacing.w : collectionView->itemSpacing.h;
+	const int lineSpacing = vertical ? collectionView->itemSpacing.h : collectionView->itemSpacing.w;
+
+	const int laneStride = max(laneSize + spacing, 1);
+	const int lanes = max(1, (limit + spacing) / laneStride);
+
+	int *ends = calloc(lanes, sizeof(int));
+	assert(ends);
+
+	for (size_t i = 0; i < index; i++) {
+
+		const SDL_Rect *frame = self->attributes + i;
+
+		const int lane = min((vertical ? frame->x : frame->y) / laneStride, lanes - 1);
+		const int end = vertical ? frame->y + frame->h : frame->x + frame->w;
+
+		ends[lane] = max(ends[lane], end + lineSpacing);
+	}
+
+	for (size_t i = index; i < self->count; i++) {
+
+		const SDL_Size size = $(collectionView, sizeForItemAtIndex, i);
+
+		const int length = vertical ? size.w : size.h;
+		int thickness = vertical ? size.h : size.w;
+
+		if (length > 0) {
+			thickness = thickness * laneSize / length;
+		}
+
+		int lane = 0;
+		for (int j = 1; j < lanes; j++) {
+			if (ends[j] < ends[lane]) {
+				lane = j;
+			}
+		}
+
+		if (vertical) {
+			self->attributes[i] = MakeRect(lane * laneStride, ends[lane], laneSize, thickness);
+		} else {
+			self->attributes[i] = MakeRect(ends[lane], lane * laneStride, thickness, laneSize);
+		}
+
+		ends[lane] += thickness + lineSpacing;
+	}
+
+	free(ends);
+}
+
+#pragma mark - CollectionViewMasonryLayout
+
+/**
+ * @fn CollectionViewMasonryLayout *CollectionViewMasonryLayout::init(CollectionViewMasonryLayout *self)
+ * @memberof CollectionViewMasonryLayout
+ */
+static CollectionViewMasonryLayout *init(CollectionViewMasonryLayout *self) {
+	return (CollectionViewMasonryLayout *) super(CollectionViewLayout, self, init);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((CollectionViewLayoutInterface *) clazz->def->interface)->layoutItems = layoutItems;
+
+	((CollectionViewMasonryLayoutInterface *) clazz->def->interface)->init = init;
+}
+
+/**
+ * @fn Class *CollectionViewMasonryLayout::_CollectionViewMasonryLayout(void)
+ * @memberof CollectionViewMasonryLayout
+ */
+Class *_CollectionViewMasonryLayout(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "CollectionViewMasonryLayout";
+		clazz.superclass = _CollectionViewLayout();
+		clazz.instanceSize = sizeof(CollectionViewMasonryLayout);
+		clazz.interfaceOffset = offsetof(CollectionViewMasonryLayout, interface);
+		clazz.interfaceSize = sizeof(CollectionViewMasonryLayoutInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,84 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <ObjectivelyMVC/CollectionViewLayout.h>
+
+/**
+ * @file
+ * @brief The CollectionViewMasonryLayout type.
+ */
+
+typedef struct CollectionViewMasonryLayout CollectionViewMasonryLayout;
+typedef struct CollectionViewMasonryLayoutInterface CollectionViewMasonryLayoutInterface;
+
+/**
+ * @brief CollectionViewMasonryLayouts arrange items of varying sizes in lanes.
+ * @details Lanes are as wide as the CollectionView's `itemSize`, and each item is scaled to the
+ * lane width, preserving its aspect ratio, and placed in the shortest lane. Item sizes are provided
+ * by the CollectionViewDelegate.
+ * @extends CollectionViewLayout
+ * @ingroup CollectionViews
+ */
+struct CollectionViewMasonryLayout {
+
+	/**
+	 * @brief The superclass.
+	 */
+	CollectionViewLayout collectionViewLayout;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	CollectionViewMasonryLayoutInterface *interface;
+};
+
+/**
+ * @brief The CollectionViewMasonryLayout interface.
+ */
+struct CollectionViewMasonryLayoutInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	CollectionViewLayoutInterface collectionViewLayoutInterface;
+
+	/**
+	 * @fn CollectionViewMasonryLayout *CollectionViewMasonryLayout::init(CollectionViewMasonryLayout *self)
+	 * @brief Initializes this CollectionViewMasonryLayout.
+	 * @param self The CollectionViewMasonryLayout.
+	 * @return The initialized CollectionViewMasonryLayout, or `NULL` on error.
+	 * @memberof CollectionViewMasonryLayout
+	 */
+	CollectionViewMasonryLayout *(*init)(CollectionViewMasonryLayout *self);
+};
+
+/**
+ * @fn Class *CollectionViewMasonryLayout::_CollectionViewMasonryLayout(void)
+ * @brief The CollectionViewMasonryLayout archetype.
+ * @return The CollectionViewMasonryLayout Class.
+ * @memberof CollectionViewMasonryLayout
+ */
+OBJECTIVELYMVC_EXPORT Class *_CollectionViewMasonryLayout(void);
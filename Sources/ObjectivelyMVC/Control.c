@@ -60,7 +60,9 @@ static void dealloc(Object *self) {
 
 	Control *this = (Control *) self;
 
-	release(this->actions);
+	if (this->actions) {
+		release(this->actions);
+	}
 
 	super(Object, self, dealloc);
 }
@@ -209,7 +211,11 @@ static void respondToEvent(View *self, const SDL_Event *event) {
  */
 static Action *actionForEvent(const Control *self, const SDL_Event *event) {
 
-	Array *actions = (Array *) self->actions;
+	const Array *actions = (Array *) self->actions;
+	if (actions == NULL) {
+		return NULL;
+	}
+
 	for (size_t i = 0; i < actions->count; i++) {
 
 		Action *action = (Action *) $(actions, objectAtIndex, i);
@@ -229,6 +235,11 @@ static void addActionForEventType(Control *self, SDL_EventType eventType, Action
 
 	Action *action = $(alloc(Action), initWithEventType, eventType, function, sender, data);
 
+	if (self->actions == NULL) {
+		self->actions = $$(MutableArray, array);
+		assert(self->actions);
+	}
+
 	$(self->actions, addObject, action);
 
 	release(action);
@@ -275,9 +286,6 @@ static Control *initWithFrame(Control *self, const SDL_Rect *frame, ControlStyle
 	self = (Control *) super(View, self, initWithFrame, frame);
 	if (self) {
 
-		self->actions = $$(MutableArray, array);
-		assert(self->actions);
-
 		self->style = style;
 		if (self->style == ControlStyleDefault) {
 
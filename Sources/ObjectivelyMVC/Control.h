@@ -106,6 +106,7 @@ struct Control {
 
 	/**
 	 * @brief The Actions bound to this Control.
+	 * @remarks This is `NULL` until the first Action is added.
 	 * @private
 	 */
 	MutableArray *actions;
@@ -0,0 +1,651 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ObjectivelyMVC/FlexView.h>
+
+const EnumName FlexViewAlignmentNames[] = MakeEnumNames(
+	MakeEnumName(FlexViewAlignmentStart),
+	MakeEnumName(FlexViewAlignmentCenter),
+	MakeEnumName(FlexViewAlignmentEnd),
+	MakeEnumName(FlexViewAlignmentStretch)
+);
+
+const EnumName FlexViewDirectionNames[] = MakeEnumNames(
+	MakeEnumName(FlexViewDirectionRow),
+	MakeEnumName(FlexViewDirectionColumn)
+);
+
+const EnumName FlexViewJustificationNames[] = MakeEnumNames(
+	MakeEnumName(FlexViewJustificationStart),
+	MakeEnumName(FlexViewJustificationCenter),
+	MakeEnumName(FlexViewJustificationEnd),
+	MakeEnumName(FlexViewJustificationSpaceBetween),
+	MakeEnumName(FlexViewJustificationSpaceAround)
+);
+
+/**
+ * @brief A subview being arranged by a FlexView.
+ */
+typedef struct {
+
+	/**
+	 * @brief The subview.
+	 */
+	View *view;
+
+	/**
+	 * @brief The flex item properties of the subview.
+	 */
+	const ViewFlex *flex;
+
+	/**
+	 * @brief The size along the main axis before growing or shrinking.
+	 */
+	float base;
+
+	/**
+	 * @brief The size along the main axis.
+	 */
+	float main;
+
+	/**
+	 * @brief The measured size along the cross axis.
+	 */
+	float cross;
+
+	/**
+	 * @brief True once `main` is resolved.
+	 */
+	_Bool frozen;
+} FlexViewItem;
+
+/**
+ * @brief A line of items.
+ */
+typedef struct {
+
+	/**
+	 * @brief The index of the first item.
+	 */
+	size_t first;
+
+	/**
+	 * @brief The count of items.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The size of the line along the main and cross axes.
+	 */
+	float main, cross;
+} FlexViewLine;
+
+/**
+ * @brief The items measured by FlexView::sizeThatFits for the FlexView being laid out on the
+ * calling thread, so that its layoutSubviews does not measure them a second time.
+ */
+static __thread struct {
+
+	/**
+	 * @brief The FlexView being laid out, or `NULL`.
+	 */
+	const FlexView *view;
+
+	/**
+	 * @brief The items, or `NULL` if there are none.
+	 */
+	FlexViewItem *items;
+
+	/**
+	 * @brief The count of `items`.
+	 */
+	size_t count;
+
+	/**
+	 * @brief True once `items` are measured.
+	 */
+	_Bool measured;
+} _measuredItems;
+
+#define _Class _FlexView
+
+/**
+ * @return True if the given subview is arranged by its FlexView, false otherwise.
+ */
+static _Bool isFlexed(const View *subview) {
+	return subview->hidden == false && subview->alignment != ViewAlignmentInternal;
+}
+
+/**
+ * @return The component of the given size along the main axis.
+ */
+static int mainSize(const FlexView *self, const SDL_Size *size) {
+	return self->direction == FlexViewDirectionRow ? size->w : size->h;
+}
+
+/**
+ * @return The component of the given size along the cross axis.
+ */
+static int crossSize(const FlexView *self, const SDL_Size *size) {
+	return self->direction == FlexViewDirectionRow ? size->h : size->w;
+}
+
+/**
+ * @return The given value clamped to the given minimum and maximum, where a maximum of `0` is
+ * unbounded.
+ */
+static float clampSize(float value, int min, int max) {
+
+	if (max > 0 && value > max) {
+		value = max;
+	}
+
+	if (value < min) {
+		value = min;
+	}
+
+	return value;
+}
+
+/**
+ * @return The given size clamped to the main axis constraints of the given item.
+ */
+static float clampMain(const FlexView *self, const FlexViewItem *item, float value) {
+
+	const ViewFlex *flex = item->flex;
+
+	return clampSize(value, mainSize(self, &flex->minSize), mainSize(self, &flex->maxSize));
+}
+
+/**
+ * @return The given size clamped to the cross axis constraints of the given item.
+ */
+static float clampCross(const FlexView *self, const FlexViewItem *item, float value) {
+
+	const ViewFlex *flex = item->flex;
+
+	return clampSize(value, crossSize(self, &flex->minSize), crossSize(self, &flex->maxSize));
+}
+
+/**
+ * @brief Measures the flexed subviews of the given FlexView, each exactly once.
+ * @return The items, which must be freed, or `NULL` if there are none.
+ */
+static FlexViewItem *measureItems(const FlexView *self, size_t *count) {
+
+	*count = 0;
+
+	const Array *subviews = (Array *) self->view.subviews;
+	if (subviews == NULL || subviews->count == 0) {
+		return NULL;
+	}
+
+	FlexViewItem *items = calloc(subviews->count, sizeof(FlexViewItem));
+	assert(items);
+
+	for (size_t i = 0; i < subviews->count; i++) {
+
+		View *subview = $(subviews, objectAtIndex, i);
+		if (isFlexed(subview) == false) {
+			continue;
+		}
+
+		FlexViewItem *item = &items[(*count)++];
+		item->view = subview;
+		item->flex = subview->flex ?: &ViewFlexDefaults;
+
+		const SDL_Size size = $(subview, sizeThatContains);
+
+		item->base = item->flex->basis > -1 ? item->flex->basis : mainSize(self, &size);
+		item->main = clampMain(self, item, item->base);
+		item->cross = clampCross(self, item, crossSize(self, &size));
+	}
+
+	if (*count == 0) {
+		free(items);
+		items = NULL;
+	}
+
+	return items;
+}
+
+/**
+ * @brief Breaks the given items into lines no longer than `available`, if `wraps` is set.
+ * @return The lines, which must be freed.
+ */
+static FlexViewLine *breakLines(const FlexView *self, const FlexViewItem *items, size_t count, float available, size_t *numberOfLines) {
+
+	FlexViewLine *lines = calloc(count, sizeof(FlexViewLine));
+	assert(lines);
+
+	FlexViewLine *line = lines;
+
+	for (size_t i = 0; i < count; i++) {
+
+		const FlexViewItem *item = &items[i];
+
+		if (line->count) {
+			const float main = line->main + self->spacing + item->main;
+			if (self->wraps && available > 0 && main > available) {
+				line++;
+			}
+		}
+
+		if (line->count == 0) {
+			line->first = i;
+		} else {
+			line->main += self->spacing;
+		}
+
+		line->count++;
+		line->main += item->main;
+		line->cross = max(line->cross, item->cross);
+	}
+
+	*numberOfLines = line - lines + 1;
+	return lines;
+}
+
+/**
+ * @brief Grows or shrinks the items of the given line to fill `available`, within their
+ * constraints.
+ * @remarks Items whose constraints are violated are frozen at their constraints, and the
+ * remaining space is redistributed among the others, as in CSS flexbox.
+ */
+static void resolveLine(const FlexView *self, FlexViewItem *items, const FlexViewLine *line, float available) {
+
+	FlexViewItem *first = items + line->first, *last = first + line->count;
+
+	float used = self->spacing * (line->count - 1);
+	for (FlexViewItem *item = first; item < last; item++) {
+		used += item->base;
+	}
+
+	const _Bool grow = available - used > 0;
+
+	for (FlexViewItem *item = first; item < last; item++) {
+		const float factor = grow ? item->flex->grow : item->flex->shrink;
+
+		item->frozen = factor <= 0.0;
+		item->main = clampMain(self, item, item->base);
+	}
+
+	for (size_t i = 0; i < line->count; i++) {
+
+		float remaining = available - self->spacing * (line->count - 1), factors = 0.0;
+
+		for (FlexViewItem *item = first; item < last; item++) {
+			if (item->frozen) {
+				remaining -= item->main;
+			} else {
+				remaining -= item->base;
+				factors += grow ? item->flex->grow : item->flex->shrink * item->base;
+			}
+		}
+
+		if (factors <= 0.0) {
+			break;
+		}
+
+		float violation = 0.0;
+
+		for (FlexViewItem *item = first; item < last; item++) {
+			if (item->frozen == false) {
+
+				const float factor = grow ? item->flex->grow : item->flex->shrink * item->base;
+				const float target = item->base + remaining * factor / factors;
+
+				item->main = clampMain(self, item, target);
+				violation += item->main - target;
+			}
+		}
+
+		if (violation == 0.0) {
+			break;
+		}
+
+		for (FlexViewItem *item = first; item < last; item++) {
+			if (item->frozen == false) {
+
+				const float factor = grow ? item->flex->grow : item->flex->shrink * item->base;
+				const float target = item->base + remaining * factor / factors;
+
+				if (violation > 0.0 ? item->main > target : item->main < target) {
+					item->frozen = true;
+				}
+			}
+		}
+	}
+}
+
+#pragma mark - View
+
+/**
+ * @see View::awakeWithDictionary(View *, const Dictionary *)
+ */
+static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
+
+	super(View, self, awakeWithDictionary, dictionary);
+
+	FlexView *this = (FlexView *) self;
+
+	const Inlet inlets[] = MakeInlets(
+		MakeInlet("alignItems", InletTypeEnum, &this->alignItems, (ident) FlexViewAlignmentNames),
+		MakeInlet("direction", InletTypeEnum, &this->direction, (ident) FlexViewDirectionNames),
+		MakeInlet("justifyContent", InletTypeEnum, &this->justifyContent, (ident) FlexViewJustificationNames),
+		MakeInlet("lineSpacing", InletTypeInteger, &this->lineSpacing, NULL),
+		MakeInlet("spacing", InletTypeInteger, &this->spacing, NULL),
+		MakeInlet("wraps", InletTypeBool, &this->wraps, NULL)
+	);
+
+	$(self, bind, dictionary, inlets);
+}
+
+/**
+ * @see View::init(View *)
+ */
+static View *init(View *self) {
+	return (View *) $((FlexView *) self, initWithFrame, NULL);
+}
+
+/**
+ * @see View::layoutState(const View *, int *, size_t)
+ */
+static size_t layoutState(const View *self, int *states, size_t count) {
+
+	const FlexView *this = (FlexView *) self;
+
+	const int state[] = {
+		this->alignItems,
+		this->direction,
+		this->justifyContent,
+		this->lineSpacing,
+		this->spacing,
+		this->wraps
+	};
+
+	memcpy(states, state, min(count, lengthof(state)) * sizeof(int));
+	return lengthof(state);
+}
+
+/**
+ * @see View::layoutSubviews(View *)
+ * @remarks This does not call the superclass implementation, which would measure every subview
+ * a second time. The items measured while sizing this FlexView to contain them are reused.
+ */
+static void layoutSubviews(View *self) {
+
+	FlexView *this = (FlexView *) self;
+
+	FlexViewItem *items = NULL;
+	size_t count = 0;
+
+	if (self->autoresizingMask & ViewAutoresizingContain) {
+
+		_measuredItems.view = this;
+		_measuredItems.measured = false;
+
+		$(self, sizeToContain);
+
+		if (_measuredItems.view == this && _measuredItems.measured) {
+			items = _measuredItems.items;
+			count = _measuredItems.count;
+		} else {
+			items = measureItems(this, &count);
+		}
+
+		memset(&_measuredItems, 0, sizeof(_measuredItems));
+	} else {
+		items = measureItems(this, &count);
+	}
+
+	const Array *subviews = (Array *) self->subviews;
+	for (size_t i = 0; subviews && i < subviews->count; i++) {
+
+		View *subview = $(subviews, objectAtIndex, i);
+		if (isFlexed(subview) == false) {
+
+			const SDL_Size size = $(subview, sizeThatContains);
+			$(subview, resize, &size);
+		}
+	}
+
+	if (items == NULL) {
+		return;
+	}
+
+	const SDL_Rect bounds = $(self, bounds);
+	const SDL_Size boundsSize = MakeSize(bounds.w, bounds.h);
+
+	const float available = mainSize(this, &boundsSize);
+
+	size_t numberOfLines;
+	FlexViewLine *lines = breakLines(this, items, count, available, &numberOfLines);
+
+	float crossPosition = 0.0;
+
+	for (size_t i = 0; i < numberOfLines; i++) {
+
+		FlexViewLine *line = &lines[i];
+
+		resolveLine(this, items, line, available);
+
+		if (numberOfLines == 1 && this->wraps == false) {
+			line->cross = crossSize(this, &boundsSize);
+		}
+
+		float used = this->spacing * (line->count - 1);
+		for (size_t j = 0; j < line->count; j++) {
+			used += items[line->first + j].main;
+		}
+
+		const float remaining = max(available - used, 0.0);
+
+		float position = 0.0, between = 0.0;
+		switch (this->justifyContent) {
+			case FlexViewJustificationStart:
+				break;
+			case FlexViewJustificationCenter:
+				position = remaining * 0.5;
+				break;
+			case FlexViewJustificationEnd:
+				position = remaining;
+				break;
+			case FlexViewJustificationSpaceBetween:
+				between = line->count > 1 ? remaining / (line->count - 1) : 0.0;
+				break;
+			case FlexViewJustificationSpaceAround:
+				between = remaining / line->count;
+				position = between * 0.5;
+				break;
+		}
+
+		for (size_t j = 0; j < line->count; j++) {
+
+			const FlexViewItem *item = &items[line->first + j];
+
+			float cross = item->cross, offset = 0.0;
+			switch (this->alignItems) {
+				case FlexViewAlignmentStart:
+					break;
+				case FlexViewAlignmentCenter:
+					offset = (line->cross - cross) * 0.5;
+					break;
+				case FlexViewAlignmentEnd:
+					offset = line->cross - cross;
+					break;
+				case FlexViewAlignmentStretch:
+					cross = clampCross(this, item, line->cross);
+					break;
+			}
+
+			const int mainStart = position + 0.5, mainEnd = position + item->main + 0.5;
+			const int crossStart = crossPosition + offset + 0.5, crossEnd = crossPosition + offset + cross + 0.5;
+
+			View *subview = item->view;
+
+			SDL_Size size;
+			switch (this->direction) {
+				case FlexViewDirectionRow:
+					subview->frame.x = mainStart;
+					subview->frame.y = crossStart;
+					size = MakeSize(mainEnd - mainStart, crossEnd - crossStart);
+					break;
+				case FlexViewDirectionColumn:
+					subview->frame.x = crossStart;
+					subview->frame.y = mainStart;
+					size = MakeSize(crossEnd - crossStart, mainEnd - mainStart);
+					break;
+			}
+
+			$(subview, resize, &size);
+
+			position += item->main + this->spacing + between;
+		}
+
+		crossPosition += line->cross + this->lineSpacing;
+	}
+
+	free(lines);
+	free(items);
+}
+
+/**
+ * @see View::sizeThatFits(const View *)
+ * @remarks While this FlexView is being laid out, its measured items are kept for
+ * layoutSubviews.
+ */
+static SDL_Size sizeThatFits(const View *self) {
+
+	SDL_Size size;
+
+	if (self->autoresizingMask & ViewAutoresizingContain) {
+
+		const FlexView *this = (FlexView *) self;
+
+		float main = 0.0, cross = 0.0;
+
+		size_t count;
+		FlexViewItem *items = measureItems(this, &count);
+		if (items) {
+
+			const SDL_Rect bounds = $(self, bounds);
+			const SDL_Size boundsSize = MakeSize(bounds.w, bounds.h);
+
+			size_t numberOfLines;
+			FlexViewLine *lines = breakLines(this, items, count, mainSize(this, &boundsSize), &numberOfLines);
+
+			for (size_t i = 0; i < numberOfLines; i++) {
+				main = max(main, lines[i].main);
+				cross += lines[i].cross;
+			}
+
+			cross += this->lineSpacing * (numberOfLines - 1);
+
+			free(lines);
+		}
+
+		if (_measuredItems.view == this && _measuredItems.measured == false) {
+			_measuredItems.items = items;
+			_measuredItems.count = count;
+			_measuredItems.measured = true;
+		} else {
+			free(items);
+		}
+
+		switch (this->direction) {
+			case FlexViewDirectionRow:
+				size = MakeSize(main, cross);
+				break;
+			case FlexViewDirectionColumn:
+				size = MakeSize(cross, main);
+				break;
+		}
+
+		size.w += self->padding.left + self->padding.right;
+		size.h += self->padding.top + self->padding.bottom;
+	} else {
+		size = super(View, self, sizeThatFits);
+	}
+
+	return size;
+}
+
+#pragma mark - FlexView
+
+/**
+ * @fn FlexView *FlexView::initWithFrame(FlexView *self, const SDL_Rect *frame)
+ * @memberof FlexView
+ */
+static FlexView *initWithFrame(FlexView *self, const SDL_Rect *frame) {
+
+	self = (FlexView *) super(View, self, initWithFrame, frame);
+	if (self) {
+		self->view.autoresizingMask = ViewAutoresizingContain;
+	}
+
+	return self;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((ViewInterface *) clazz->def->interface)->awakeWithDictionary = awakeWithDictionary;
+	((ViewInterface *) clazz->def->interface)->init = init;
+	((ViewInterface *) clazz->def->interface)->layoutState = layoutState;
+	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
+	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
+
+	((FlexViewInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
+}
+
+/**
+ * @fn Class *FlexView::_FlexView(void)
+ * @memberof FlexView
+ */
+Class *_FlexView(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "FlexView";
+		clazz.superclass = _View();
+		clazz.instanceSize = sizeof(FlexView);
+		clazz.interfaceOffset = offsetof(FlexView, interface);
+		clazz.interfaceSize = sizeof(FlexViewInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
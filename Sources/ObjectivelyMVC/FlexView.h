@@ -0,0 +1,153 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <ObjectivelyMVC/View.h>
+
+/**
+ * @file
+ * @brief FlexViews are containers that arrange their subviews in flexible lines.
+ */
+
+/**
+ * @brief Direction constants for specifying a FlexView's main axis.
+ */
+typedef enum {
+	FlexViewDirectionRow,
+	FlexViewDirectionColumn
+} FlexViewDirection;
+
+OBJECTIVELYMVC_EXPORT const EnumName FlexViewDirectionNames[];
+
+/**
+ * @brief Justification constants for distributing free space along a FlexView's main axis.
+ */
+typedef enum {
+	FlexViewJustificationStart,
+	FlexViewJustificationCenter,
+	FlexViewJustificationEnd,
+	FlexViewJustificationSpaceBetween,
+	FlexViewJustificationSpaceAround
+} FlexViewJustification;
+
+OBJECTIVELYMVC_EXPORT const EnumName FlexViewJustificationNames[];
+
+/**
+ * @brief Alignment constants for positioning subviews along a FlexView's cross axis.
+ */
+typedef enum {
+	FlexViewAlignmentStart,
+	FlexViewAlignmentCenter,
+	FlexViewAlignmentEnd,
+	FlexViewAlignmentStretch
+} FlexViewAlignment;
+
+OBJECTIVELYMVC_EXPORT const EnumName FlexViewAlignmentNames[];
+
+typedef struct FlexView FlexView;
+typedef struct FlexViewInterface FlexViewInterface;
+
+/**
+ * @brief FlexViews are containers that arrange their subviews in flexible lines.
+ * @details Subviews are laid out along the main axis from their `flex` basis, and then grow to
+ * fill free space or shrink to remove overflow, within their minimum and maximum sizes. If
+ * `wraps` is set, subviews that overflow the main axis begin a new line.
+ * @details Layout is performed in two passes: subviews are measured once, and then arranged. A
+ * single FlexView can thus replace several levels of nested StackViews.
+ * @extends View
+ * @ingroup Containers
+ */
+struct FlexView {
+
+	/**
+	 * @brief The superclass.
+	 */
+	View view;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	FlexViewInterface *interface;
+
+	/**
+	 * @brief The alignment of subviews along the cross axis.
+	 */
+	FlexViewAlignment alignItems;
+
+	/**
+	 * @brief The main axis.
+	 */
+	FlexViewDirection direction;
+
+	/**
+	 * @brief The distribution of free space along the main axis.
+	 */
+	FlexViewJustification justifyContent;
+
+	/**
+	 * @brief The spacing between lines.
+	 */
+	int lineSpacing;
+
+	/**
+	 * @brief The spacing between subviews within a line.
+	 */
+	int spacing;
+
+	/**
+	 * @brief If true, subviews that overflow the main axis begin a new line.
+	 */
+	_Bool wraps;
+};
+
+/**
+ * @brief The FlexView interface.
+ */
+struct FlexViewInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ViewInterface viewInterface;
+
+	/**
+	 * @fn FlexView *FlexView::initWithFrame(FlexView *self, const SDL_Rect *frame)
+	 * @brief Initializes this FlexView with the specified frame.
+	 * @param self The FlexView.
+	 * @param frame The frame.
+	 * @return The initialized FlexView, or `NULL` on error.
+	 * @memberof FlexView
+	 */
+	FlexView *(*initWithFrame)(FlexView *self, const SDL_Rect *frame);
+};
+
+/**
+ * @fn Class *FlexView::_FlexView(void)
+ * @brief The FlexView archetype.
+ * @return The FlexView Class.
+ * @memberof FlexView
+ */
+OBJECTIVELYMVC_EXPORT Class *_FlexView(void);
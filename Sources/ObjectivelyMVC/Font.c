@@ -32,6 +32,11 @@
 #include <ObjectivelyMVC/Log.h>
 #include <ObjectivelyMVC/View.h>
 
+/**
+ * @brief Serializes access to SDL_ttf, so that Views may be measured on LayoutQueue threads.
+ */
+static SDL_mutex *_lock;
+
 #define _Class _Font
 
 #pragma mark - Object
@@ -257,7 +262,14 @@ static Font *initWithPattern(Font *self, ident pattern) {
  * @memberof Font
  */
 static SDL_Surface *renderCharacters(const Font *self, const char *chars, SDL_Color color) {
-	return TTF_RenderUTF8_Blended(self->font, chars, color);
+
+	SDL_LockMutex(_lock);
+
+	SDL_Surface *surface = TTF_RenderUTF8_Blended(self->font, chars, color);
+
+	SDL_UnlockMutex(_lock);
+
+	return surface;
 }
 
 /**
@@ -279,8 +291,12 @@ static void renderDeviceDidReset(Font *self) {
  */
 static void sizeCharacters(const Font *self, const char *chars, int *w, int *h) {
 
+	SDL_LockMutex(_lock);
+
 	TTF_SizeUTF8(self->font, chars, w, h);
 
+	SDL_UnlockMutex(_lock);
+
 	const float scale = MVC_WindowScale(NULL, NULL, NULL);
 	if (w) {
 		*w /= scale;
@@ -313,6 +329,9 @@ static void initialize(Class *clazz) {
 
 	const int err = TTF_Init();
 	assert(err == 0);
+
+	_lock = SDL_CreateMutex();
+	assert(_lock);
 }
 
 /**
@@ -326,6 +345,8 @@ static void destroy(Class *clazz) {
 
 	FcFini();
 	TTF_Quit();
+
+	SDL_DestroyMutex(_lock);
 }
 
 /**
@@ -0,0 +1,777 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ObjectivelyMVC/GridView.h>
+
+/**
+ * @brief A subview of a GridView, as placed and measured.
+ */
+typedef struct {
+
+	/**
+	 * @brief The subview.
+	 */
+	View *view;
+
+	/**
+	 * @brief True if the subview occupies a cell, false if it is hidden or internal.
+	 */
+	_Bool placed;
+
+	/**
+	 * @brief The resolved cell.
+	 */
+	int column, columnSpan, row, rowSpan;
+
+	/**
+	 * @brief The measured size.
+	 */
+	SDL_Size size;
+
+	/**
+	 * @brief The frame size and hidden state of the subview after it was last laid out.
+	 */
+	SDL_Size frameSize;
+	_Bool hidden;
+} GridViewItem;
+
+/**
+ * @brief The measured tracks and subviews of a GridView.
+ */
+struct GridViewLayout {
+
+	/**
+	 * @brief The items, one per subview.
+	 */
+	GridViewItem *items;
+
+	/**
+	 * @brief The count of `items`.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The natural sizes of the columns and rows, including implicit tracks.
+	 */
+	float *columns, *rows;
+
+	/**
+	 * @brief The counts of `columns` and `rows`.
+	 */
+	size_t numberOfColumns, numberOfRows;
+
+	/**
+	 * @brief True if the items and natural sizes are current.
+	 */
+	_Bool valid;
+};
+
+#define _Class _GridView
+
+/**
+ * @return True if the given subview occupies a cell, false otherwise.
+ */
+static _Bool isGridded(const View *subview) {
+	return subview->hidden == false && subview->alignment != ViewAlignmentInternal;
+}
+
+/**
+ * @return The track at the given index, which is automatic if it is not defined.
+ */
+static GridViewTrack trackAtIndex(const GridViewTrack *tracks, size_t count, size_t index) {
+	return index < count ? tracks[index] : MakeGridViewTrack(GridViewTrackSizingAuto, 0.0);
+}
+
+/**
+ * @brief Resolves the cells of the subviews of the given GridView.
+ */
+static void placeItems(GridView *self) {
+
+	GridViewLayout *layout = self->layout;
+
+	const Array *subviews = (Array *) self->view.subviews;
+	const size_t count = subviews ? subviews->count : 0;
+
+	if (count > layout->count) {
+		layout->items = realloc(layout->items, count * sizeof(GridViewItem));
+		assert(layout->items);
+	}
+
+	layout->count = count;
+
+	const int numberOfColumns = max((int) self->numberOfColumns, 1);
+
+	layout->numberOfColumns = numberOfColumns;
+	layout->numberOfRows = self->numberOfRows;
+
+	int cursorColumn = 0, cursorRow = 0;
+
+	for (size_t i = 0; i < count; i++) {
+
+		GridViewItem *item = &layout->items[i];
+		memset(item, 0, sizeof(*item));
+
+		View *subview = $(subviews, objectAtIndex, i);
+
+		item->view = subview;
+		item->frameSize = $(subview, size);
+		item->hidden = subview->hidden;
+
+		if (isGridded(subview) == false) {
+			continue;
+		}
+
+		const ViewGridCell *cell = subview->gridCell ?: &ViewGridCellDefaults;
+
+		item->placed = true;
+		item->columnSpan = max(cell->columnSpan, 1);
+		item->rowSpan = max(cell->rowSpan, 1);
+
+		if (cell->column == -1 && cell->row == -1) {
+			if (cursorColumn && cursorColumn + item->columnSpan > numberOfColumns) {
+				cursorColumn = 0;
+				cursorRow++;
+			}
+
+			item->column = cursorColumn;
+			item->row = cursorRow;
+
+			cursorColumn += item->columnSpan;
+		} else {
+			item->column = max(cell->column, 0);
+			item->row = cell->row > -1 ? cell->row : cursorRow;
+		}
+
+		layout->numberOfColumns = max(layout->numberOfColumns, (size_t) (item->column + item->columnSpan));
+		layout->numberOfRows = max(layout->numberOfRows, (size_t) (item->row + item->rowSpan));
+	}
+}
+
+/**
+ * @brief Grows the non-fixed tracks spanned by an item so that they contain `size`.
+ */
+static void spanTracks(const GridViewTrack *tracks, size_t numberOfTracks, float *sizes, int first, int span, int spacing, int size) {
+
+	float needed = size - spacing * (span - 1);
+	int flexible = 0;
+
+	for (int i = first; i < first + span; i++) {
+		needed -= sizes[i];
+
+		if (trackAtIndex(tracks, numberOfTracks, i).sizing != GridViewTrackSizingFixed) {
+			flexible++;
+		}
+	}
+
+	if (needed > 0.0 && flexible) {
+		for (int i = first; i < first + span; i++) {
+			if (trackAtIndex(tracks, numberOfTracks, i).sizing != GridViewTrackSizingFixed) {
+				sizes[i] += needed / flexible;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Sizes fixed tracks, and sizes fractional tracks in proportion to the largest content
+ * per fraction among them.
+ */
+static void sizeTracks(const GridViewTrack *tracks, size_t numberOfTracks, float *sizes, size_t count) {
+
+	float unit = 0.0;
+
+	for (size_t i = 0; i < count; i++) {
+		const GridViewTrack track = trackAtIndex(tracks, numberOfTracks, i);
+		switch (track.sizing) {
+			case GridViewTrackSizingAuto:
+				break;
+			case GridViewTrackSizingFixed:
+				sizes[i] = track.value;
+				break;
+			case GridViewTrackSizingFraction:
+				if (track.value > 0.0) {
+					unit = max(unit, sizes[i] / track.value);
+				}
+				break;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		const GridViewTrack track = trackAtIndex(tracks, numberOfTracks, i);
+		if (track.sizing == GridViewTrackSizingFraction) {
+			sizes[i] = unit * track.value;
+		}
+	}
+}
+
+/**
+ * @brief Places and measures the subviews of the given GridView, and sizes its tracks, unless
+ * they are current.
+ * @remarks Each subview is measured exactly once.
+ */
+static void measure(GridView *self) {
+
+	GridViewLayout *layout = self->layout;
+	if (layout->valid) {
+		return;
+	}
+
+	placeItems(self);
+
+	free(layout->columns);
+	free(layout->rows);
+
+	layout->columns = calloc(layout->numberOfColumns + 1, sizeof(float));
+	assert(layout->columns);
+
+	layout->rows = calloc(layout->numberOfRows + 1, sizeof(float));
+	assert(layout->rows);
+
+	for (size_t i = 0; i < layout->count; i++) {
+
+		GridViewItem *item = &layout->items[i];
+		if (item->placed == false) {
+			continue;
+		}
+
+		item->size = $(item->view, sizeThatContains);
+
+		if (item->columnSpan == 1) {
+			layout->columns[item->column] = max(layout->columns[item->column], item->size.w);
+		}
+
+		if (item->rowSpan == 1) {
+			layout->rows[item->row] = max(layout->rows[item->row], item->size.h);
+		}
+	}
+
+	for (size_t i = 0; i < layout->numberOfColumns; i++) {
+		if (trackAtIndex(self->columns, self->numberOfColumns, i).sizing == GridViewTrackSizingFixed) {
+			layout->columns[i] = self->columns[i].value;
+		}
+	}
+
+	for (size_t i = 0; i < layout->numberOfRows; i++) {
+		if (trackAtIndex(self->rows, self->numberOfRows, i).sizing == GridViewTrackSizingFixed) {
+			layout->rows[i] = self->rows[i].value;
+		}
+	}
+
+	for (size_t i = 0; i < layout->count; i++) {
+
+		const GridViewItem *item = &layout->items[i];
+		if (item->placed == false) {
+			continue;
+		}
+
+		if (item->columnSpan > 1) {
+			spanTracks(self->columns, self->numberOfColumns, layout->columns, item->column, item->columnSpan, self->columnSpacing, item->size.w);
+		}
+
+		if (item->rowSpan > 1) {
+			spanTracks(self->rows, self->numberOfRows, layout->rows, item->row, item->rowSpan, self->rowSpacing, item->size.h);
+		}
+	}
+
+	sizeTracks(self->columns, self->numberOfColumns, layout->columns, layout->numberOfColumns);
+	sizeTracks(self->rows, self->numberOfRows, layout->rows, layout->numberOfRows);
+
+	layout->valid = true;
+}
+
+/**
+ * @brief Resolves the offsets of the given tracks within `available`, distributing the space
+ * remaining after all other tracks to fractional tracks.
+ * @param offsets The offsets, of which there must be `count + 1`.
+ */
+static void resolveOffsets(const GridViewTrack *tracks, size_t numberOfTracks, const float *sizes, size_t count, int spacing, float available, float *offsets) {
+
+	float used = count ? spacing * (count - 1) : 0.0, fractions = 0.0;
+
+	for (size_t i = 0; i < count; i++) {
+		const GridViewTrack track = trackAtIndex(tracks, numberOfTracks, i);
+		if (track.sizing == GridViewTrackSizingFraction) {
+			fractions += track.value;
+		} else {
+			used += sizes[i];
+		}
+	}
+
+	const float remaining = max(available - used, 0.0);
+
+	offsets[0] = 0.0;
+
+	for (size_t i = 0; i < count; i++) {
+		const GridViewTrack track = trackAtIndex(tracks, numberOfTracks, i);
+
+		float size = sizes[i];
+		if (track.sizing == GridViewTrackSizingFraction && fractions > 0.0) {
+			size = remaining * track.value / fractions;
+		}
+
+		offsets[i + 1] = offsets[i] + size + spacing;
+	}
+}
+
+/**
+ * @return The given track definition, e.g. `120`, `"auto"` or `"1fr"`.
+ */
+static GridViewTrack trackWithObject(ident obj) {
+
+	if ($((Object *) obj, isKindOfClass, _Number())) {
+		return MakeGridViewTrack(GridViewTrackSizingFixed, cast(Number, obj)->value);
+	}
+
+	const char *chars = cast(String, obj)->chars;
+
+	if (strcmp(chars, "auto") == 0) {
+		return MakeGridViewTrack(GridViewTrackSizingAuto, 0.0);
+	}
+
+	char *end;
+	const float value = strtof(chars, &end);
+
+	if (strcmp(end, "fr") == 0) {
+		return MakeGridViewTrack(GridViewTrackSizingFraction, value);
+	}
+
+	return MakeGridViewTrack(GridViewTrackSizingFixed, value);
+}
+
+/**
+ * @return The given Array of track definitions, which must be freed.
+ */
+static GridViewTrack *tracksWithArray(const Array *array) {
+
+	GridViewTrack *tracks = calloc(array->count + 1, sizeof(GridViewTrack));
+	assert(tracks);
+
+	for (size_t i = 0; i < array->count; i++) {
+		tracks[i] = trackWithObject($(array, objectAtIndex, i));
+	}
+
+	return tracks;
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	GridView *this = (GridView *) self;
+
+	free(this->columns);
+	free(this->rows);
+
+	free(this->layout->items);
+	free(this->layout->columns);
+	free(this->layout->rows);
+	free(this->layout);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - View
+
+/**
+ * @see View::awakeWithDictionary(View *, const Dictionary *)
+ */
+static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
+
+	super(View, self, awakeWithDictionary, dictionary);
+
+	GridView *this = (GridView *) self;
+
+	const Inlet inlets[] = MakeInlets(
+		MakeInlet("columnSpacing", InletTypeInteger, &this->columnSpacing, NULL),
+		MakeInlet("rowSpacing", InletTypeInteger, &this->rowSpacing, NULL)
+	);
+
+	$(self, bind, dictionary, inlets);
+
+	const Array *columns = $(dictionary, objectForKeyPath, "columns");
+	if (columns) {
+		GridViewTrack *tracks = tracksWithArray(columns);
+		$(this, setColumns, tracks, columns->count);
+		free(tracks);
+	}
+
+	const Array *rows = $(dictionary, objectForKeyPath, "rows");
+	if (rows) {
+		GridViewTrack *tracks = tracksWithArray(rows);
+		$(this, setRows, tracks, rows->count);
+		free(tracks);
+	}
+}
+
+/**
+ * @see View::didLayoutSubviews(View *)
+ * @remarks Records the size and visibility of each subview, once laid out, so that changes to
+ * them can be detected before the next layout.
+ */
+static void didLayoutSubviews(View *self) {
+
+	super(View, self, didLayoutSubviews);
+
+	GridViewLayout *layout = ((GridView *) self)->layout;
+	if (layout->valid) {
+
+		for (size_t i = 0; i < layout->count; i++) {
+
+			GridViewItem *item = &layout->items[i];
+
+			item->frameSize = $(item->view, size);
+			item->hidden = item->view->hidden;
+		}
+	}
+}
+
+/**
+ * @see View::init(View *)
+ */
+static View *init(View *self) {
+	return (View *) $((GridView *) self, initWithFrame, NULL);
+}
+
+/**
+ * @brief Writes the given tracks to `states`, as far as `count` allows.
+ * @return The count of states the tracks have.
+ */
+static size_t layoutState_tracks(const GridViewTrack *tracks, size_t numberOfTracks, int *states, size_t count) {
+
+	for (size_t i = 0; i < numberOfTracks; i++) {
+
+		if (i * 2 + 1 < count) {
+			states[i * 2] = tracks[i].sizing;
+			memcpy(&states[i * 2 + 1], &tracks[i].value, sizeof(int));
+		}
+	}
+
+	return numberOfTracks * 2;
+}
+
+/**
+ * @see View::layoutState(const View *, int *, size_t)
+ */
+static size_t layoutState(const View *self, int *states, size_t count) {
+
+	const GridView *this = (GridView *) self;
+
+	const int state[] = {
+		this->columnSpacing,
+		this->rowSpacing,
+		(int) this->numberOfColumns,
+		(int) this->numberOfRows
+	};
+
+	size_t total = lengthof(state);
+	memcpy(states, state, min(count, total) * sizeof(int));
+
+	total += layoutState_tracks(this->columns, this->numberOfColumns, states + total, count > total ? count - total : 0);
+	total += layoutState_tracks(this->rows, this->numberOfRows, states + total, count > total ? count - total : 0);
+
+	return total;
+}
+
+/**
+ * @see View::layoutSubviews(View *)
+ * @remarks This does not call the superclass implementation, which would measure every subview
+ * a second time.
+ */
+static void layoutSubviews(View *self) {
+
+	GridView *this = (GridView *) self;
+
+	if (self->autoresizingMask & ViewAutoresizingContain) {
+		$(self, sizeToContain);
+	}
+
+	measure(this);
+
+	GridViewLayout *layout = this->layout;
+
+	const SDL_Rect bounds = $(self, bounds);
+
+	float *columns = malloc((layout->numberOfColumns + 1) * sizeof(float));
+	assert(columns);
+
+	float *rows = malloc((layout->numberOfRows + 1) * sizeof(float));
+	assert(rows);
+
+	resolveOffsets(this->columns, this->numberOfColumns, layout->columns, layout->numberOfColumns, this->columnSpacing, bounds.w, columns);
+	resolveOffsets(this->rows, this->numberOfRows, layout->rows, layout->numberOfRows, this->rowSpacing, bounds.h, rows);
+
+	for (size_t i = 0; i < layout->count; i++) {
+
+		GridViewItem *item = &layout->items[i];
+		View *subview = item->view;
+
+		if (item->placed == false) {
+			const SDL_Size size = $(subview, sizeThatContains);
+			$(subview, resize, &size);
+			continue;
+		}
+
+		const int x = columns[item->column] + 0.5, y = rows[item->row] + 0.5;
+
+		const SDL_Size cell = MakeSize(
+			(int) (columns[item->column + item->columnSpan] - this->columnSpacing + 0.5) - x,
+			(int) (rows[item->row + item->rowSpan] - this->rowSpacing + 0.5) - y
+		);
+
+		if (subview->alignment == ViewAlignmentNone) {
+			subview->frame.x = x;
+			subview->frame.y = y;
+
+			$(subview, resize, &cell);
+		} else {
+			const SDL_Size size = MakeSize(min(item->size.w, cell.w), min(item->size.h, cell.h));
+
+			subview->frame.x = x;
+			subview->frame.y = y;
+
+			if (subview->alignment & ViewAlignmentMaskCenter) {
+				subview->frame.x += (cell.w - size.w) * 0.5;
+			} else if (subview->alignment & ViewAlignmentMaskRight) {
+				subview->frame.x += cell.w - size.w;
+			}
+
+			if (subview->alignment & ViewAlignmentMaskMiddle) {
+				subview->frame.y += (cell.h - size.h) * 0.5;
+			} else if (subview->alignment & ViewAlignmentMaskBottom) {
+				subview->frame.y += cell.h - size.h;
+			}
+
+			$(subview, resize, &size);
+		}
+	}
+
+	free(columns);
+	free(rows);
+}
+
+/**
+ * @see View::sizeThatFits(const View *)
+ */
+static SDL_Size sizeThatFits(const View *self) {
+
+	SDL_Size size = super(View, self, sizeThatFits);
+
+	if (self->autoresizingMask & ViewAutoresizingContain) {
+
+		GridView *this = (GridView *) self;
+
+		measure(this);
+
+		const GridViewLayout *layout = this->layout;
+
+		size = MakeSize(0, 0);
+
+		for (size_t i = 0; i < layout->numberOfColumns; i++) {
+			size.w += layout->columns[i];
+		}
+
+		if (layout->numberOfColumns) {
+			size.w += this->columnSpacing * (layout->numberOfColumns - 1);
+		}
+
+		for (size_t i = 0; i < layout->numberOfRows; i++) {
+			size.h += layout->rows[i];
+		}
+
+		if (layout->numberOfRows) {
+			size.h += this->rowSpacing * (layout->numberOfRows - 1);
+		}
+
+		size.w += self->padding.left + self->padding.right;
+		size.h += self->padding.top + self->padding.bottom;
+	}
+
+	return size;
+}
+
+/**
+ * @see View::willLayoutSubviews(View *)
+ * @remarks Invalidates the measured tracks if any subview was added, removed, hidden, shown or
+ * resized since the last layout, or if a subview that needs layout now measures differently, e.g.
+ * because its text or image changed.
+ */
+static void willLayoutSubviews(View *self) {
+
+	super(View, self, willLayoutSubviews);
+
+	GridView *this = (GridView *) self;
+
+	const GridViewLayout *layout = this->layout;
+	if (layout->valid == false) {
+		return;
+	}
+
+	const Array *subviews = (Array *) self->subviews;
+	const size_t count = subviews ? subviews->count : 0;
+
+	_Bool changed = count != layout->count;
+
+	for (size_t i = 0; i < count && changed == false; i++) {
+
+		const GridViewItem *item = &layout->items[i];
+		const View *subview = $(subviews, objectAtIndex, i);
+
+		changed = subview != item->view
+			|| subview->hidden != item->hidden
+			|| subview->frame.w != item->frameSize.w
+			|| subview->frame.h != item->frameSize.h;
+
+		if (changed == false && item->placed && subview->needsLayout) {
+
+			const SDL_Size size = $(subview, sizeThatContains);
+
+			changed = size.w != item->size.w || size.h != item->size.h;
+		}
+	}
+
+	if (changed) {
+		$(this, invalidateTracks);
+	}
+}
+
+#pragma mark - GridView
+
+/**
+ * @fn GridView *GridView::initWithFrame(GridView *self, const SDL_Rect *frame)
+ * @memberof GridView
+ */
+static GridView *initWithFrame(GridView *self, const SDL_Rect *frame) {
+
+	self = (GridView *) super(View, self, initWithFrame, frame);
+	if (self) {
+		self->layout = calloc(1, sizeof(GridViewLayout));
+		assert(self->layout);
+
+		self->view.autoresizingMask = ViewAutoresizingContain;
+	}
+
+	return self;
+}
+
+/**
+ * @fn void GridView::invalidateTracks(GridView *self)
+ * @memberof GridView
+ */
+static void invalidateTracks(GridView *self) {
+
+	self->layout->valid = false;
+	self->view.needsLayout = true;
+}
+
+/**
+ * @fn void GridView::setColumns(GridView *self, const GridViewTrack *columns, size_t count)
+ * @memberof GridView
+ */
+static void setColumns(GridView *self, const GridViewTrack *columns, size_t count) {
+
+	free(self->columns);
+
+	self->columns = calloc(count + 1, sizeof(GridViewTrack));
+	assert(self->columns);
+
+	if (count) {
+		memcpy(self->columns, columns, count * sizeof(GridViewTrack));
+	}
+
+	self->numberOfColumns = count;
+
+	$(self, invalidateTracks);
+}
+
+/**
+ * @fn void GridView::setRows(GridView *self, const GridViewTrack *rows, size_t count)
+ * @memberof GridView
+ */
+static void setRows(GridView *self, const GridViewTrack *rows, size_t count) {
+
+	free(self->rows);
+
+	self->rows = calloc(count + 1, sizeof(GridViewTrack));
+	assert(self->rows);
+
+	if (count) {
+		memcpy(self->rows, rows, count * sizeof(GridViewTrack));
+	}
+
+	self->numberOfRows = count;
+
+	$(self, invalidateTracks);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
+
+	((ViewInterface *) clazz->def->interface)->awakeWithDictionary = awakeWithDictionary;
+	((ViewInterface *) clazz->def->interface)->didLayoutSubviews = didLayoutSubviews;
+	((ViewInterface *) clazz->def->interface)->init = init;
+	((ViewInterface *) clazz->def->interface)->layoutState = layoutState;
+	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
+	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
+	((ViewInterface *) clazz->def->interface)->willLayoutSubviews = willLayoutSubviews;
+
+	((GridViewInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
+	((GridViewInterface *) clazz->def->interface)->invalidateTracks = invalidateTracks;
+	((GridViewInterface *) clazz->def->interface)->setColumns = setColumns;
+	((GridViewInterface *) clazz->def->interface)->setRows = setRows;
+}
+
+/**
+ * @fn Class *GridView::_GridView(void)
+ * @memberof GridView
+ */
+Class *_GridView(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "GridView";
+		clazz.superclass = _View();
+		clazz.instanceSize = sizeof(GridView);
+		clazz.interfaceOffset = offsetof(GridView, interface);
+		clazz.interfaceSize = sizeof(GridViewInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
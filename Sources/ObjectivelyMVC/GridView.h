@@ -0,0 +1,193 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <ObjectivelyMVC/View.h>
+
+/**
+ * @file
+ * @brief GridViews are containers that arrange their subviews in rows and columns.
+ */
+
+/**
+ * @brief Sizing constants for GridView tracks.
+ */
+typedef enum {
+	GridViewTrackSizingAuto,
+	GridViewTrackSizingFixed,
+	GridViewTrackSizingFraction
+} GridViewTrackSizing;
+
+/**
+ * @brief A row or column of a GridView.
+ */
+typedef struct {
+
+	/**
+	 * @brief The sizing.
+	 */
+	GridViewTrackSizing sizing;
+
+	/**
+	 * @brief The size of a fixed track, or the share of free space of a fractional track.
+	 */
+	float value;
+} GridViewTrack;
+
+/**
+ * @brief Creates a GridViewTrack with the given sizing and value.
+ */
+#define MakeGridViewTrack(sizing, value) (GridViewTrack) { (sizing), (value) }
+
+typedef struct GridViewLayout GridViewLayout;
+
+typedef struct GridView GridView;
+typedef struct GridViewInterface GridViewInterface;
+
+/**
+ * @brief GridViews are containers that arrange their subviews in rows and columns.
+ * @details Tracks are sized to fit their content (auto), to a fixed size, or to a fraction of the
+ * space remaining after all other tracks. Subviews occupy the cells given by their `gridCell`,
+ * spanning one or more tracks, or are placed automatically in row-major order. Rows and columns
+ * beyond those defined are sized automatically. Subviews with an alignment of ViewAlignmentNone
+ * fill their cells, while all others are aligned within them.
+ * @details Tracks are sized in a single pass that measures each subview once. The measurements
+ * are reused until a subview is added, removed, hidden, shown or resized, or until the tracks
+ * change.
+ * @extends View
+ * @ingroup Containers
+ */
+struct GridView {
+
+	/**
+	 * @brief The superclass.
+	 */
+	View view;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	GridViewInterface *interface;
+
+	/**
+	 * @brief The columns.
+	 * @remarks Do not set this property directly.
+	 * @see GridView::setColumns(GridView *, const GridViewTrack *, size_t)
+	 */
+	GridViewTrack *columns;
+
+	/**
+	 * @brief The spacing between columns.
+	 */
+	int columnSpacing;
+
+	/**
+	 * @brief The measured tracks and subviews.
+	 * @private
+	 */
+	GridViewLayout *layout;
+
+	/**
+	 * @brief The count of `columns`.
+	 */
+	size_t numberOfColumns;
+
+	/**
+	 * @brief The count of `rows`.
+	 */
+	size_t numberOfRows;
+
+	/**
+	 * @brief The rows.
+	 * @remarks Do not set this property directly.
+	 * @see GridView::setRows(GridView *, const GridViewTrack *, size_t)
+	 */
+	GridViewTrack *rows;
+
+	/**
+	 * @brief The spacing between rows.
+	 */
+	int rowSpacing;
+};
+
+/**
+ * @brief The GridView interface.
+ */
+struct GridViewInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ViewInterface viewInterface;
+
+	/**
+	 * @fn GridView *GridView::initWithFrame(GridView *self, const SDL_Rect *frame)
+	 * @brief Initializes this GridView with the specified frame.
+	 * @param self The GridView.
+	 * @param frame The frame.
+	 * @return The initialized GridView, or `NULL` on error.
+	 * @memberof GridView
+	 */
+	GridView *(*initWithFrame)(GridView *self, const SDL_Rect *frame);
+
+	/**
+	 * @fn void GridView::invalidateTracks(GridView *self)
+	 * @brief Invalidates the measured tracks, so that they are sized again on the next layout.
+	 * @param self The GridView.
+	 * @remarks Changes to the direct subviews of this GridView are detected automatically. Call
+	 * this method when the intrinsic size of a deeper descendant changes.
+	 * @memberof GridView
+	 */
+	void (*invalidateTracks)(GridView *self);
+
+	/**
+	 * @fn void GridView::setColumns(GridView *self, const GridViewTrack *columns, size_t count)
+	 * @brief Sets the columns of this GridView.
+	 * @param self The GridView.
+	 * @param columns The columns.
+	 * @param count The count of `columns`.
+	 * @memberof GridView
+	 */
+	void (*setColumns)(GridView *self, const GridViewTrack *columns, size_t count);
+
+	/**
+	 * @fn void GridView::setRows(GridView *self, const GridViewTrack *rows, size_t count)
+	 * @brief Sets the rows of this GridView.
+	 * @param self The GridView.
+	 * @param rows The rows.
+	 * @param count The count of `rows`.
+	 * @memberof GridView
+	 */
+	void (*setRows)(GridView *self, const GridViewTrack *rows, size_t count);
+};
+
+/**
+ * @fn Class *GridView::_GridView(void)
+ * @brief The GridView archetype.
+ * @return The GridView Class.
+ * @memberof GridView
+ */
+OBJECTIVELYMVC_EXPORT Class *_GridView(void);
@@ -171,6 +171,10 @@ static ImageView *initWithImage(ImageView *self, Image *image) {
  */
 static void setImage(ImageView *self, Image *image) {
 
+	if (image == self->image) {
+		return;
+	}
+
 	release(self->image);
 
 	if (image) {
@@ -179,6 +183,10 @@ static void setImage(ImageView *self, Image *image) {
 		self->image = NULL;
 	}
 
+	if (self->texture) {
+		glDeleteTextures(1, &self->texture);
+	}
+
 	self->texture = 0;
 }
 
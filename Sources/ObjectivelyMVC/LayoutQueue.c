@@ -0,0 +1,490 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ObjectivelyMVC/LayoutQueue.h>
+#include <ObjectivelyMVC/View.h>
+#include <ObjectivelyMVC/WindowController.h>
+
+typedef struct LayoutQueueDeque LayoutQueueDeque;
+
+/**
+ * @brief A request to lay out a View subtree.
+ */
+struct LayoutQueueJob {
+
+	/**
+	 * @brief The root of the subtree.
+	 */
+	View *view;
+
+	/**
+	 * @brief A snapshot of the window metrics of the thread that dispatched this job.
+	 * @remarks Worker threads must not query SDL windows, which is not thread safe.
+	 */
+	WindowMetrics metrics;
+
+	/**
+	 * @brief Nonzero once this job has completed.
+	 */
+	SDL_atomic_t done;
+};
+
+/**
+ * @brief The jobs of a worker thread.
+ * @remarks The owning thread pushes and pops jobs at the tail, while other threads steal them from
+ * the head. All members are guarded by `lock`.
+ */
+struct LayoutQueueDeque {
+
+	/**
+	 * @brief The lock.
+	 */
+	SDL_mutex *lock;
+
+	/**
+	 * @brief The jobs.
+	 */
+	LayoutQueueJob **jobs;
+
+	/**
+	 * @brief The indexes of the oldest job, and one past the newest job.
+	 */
+	size_t head, tail;
+
+	/**
+	 * @brief The capacity of `jobs`.
+	 */
+	size_t capacity;
+
+	/**
+	 * @brief The workers owning this deque.
+	 */
+	LayoutQueueWorkers *workers;
+};
+
+/**
+ * @brief The worker threads of a LayoutQueue, and their jobs.
+ */
+struct LayoutQueueWorkers {
+
+	/**
+	 * @brief The lock guarding `quit`, and on which threads sleep.
+	 */
+	SDL_mutex *lock;
+
+	/**
+	 * @brief The condition signaled when jobs are pending, or when the workers should quit.
+	 */
+	SDL_cond *condition;
+
+	/**
+	 * @brief The condition signaled when a job completes.
+	 */
+	SDL_cond *completed;
+
+	/**
+	 * @brief The worker threads.
+	 */
+	SDL_Thread *threads[MAX_LAYOUT_QUEUE_THREADS];
+
+	/**
+	 * @brief The count of `threads`.
+	 */
+	int numberOfThreads;
+
+	/**
+	 * @brief The deques of the worker threads, followed by the deque shared by all other threads.
+	 */
+	LayoutQueueDeque deques[MAX_LAYOUT_QUEUE_THREADS + 1];
+
+	/**
+	 * @brief The count of jobs awaiting a thread.
+	 */
+	SDL_atomic_t pending;
+
+	/**
+	 * @brief True when the workers should quit.
+	 */
+	_Bool quit;
+};
+
+/**
+ * @brief The deque of the calling thread, if it is a worker thread.
+ */
+static __thread LayoutQueueDeque *_deque;
+
+#define _Class _LayoutQueue
+
+/**
+ * @brief Captures the metrics of the current OpenGL window, if any, on the calling thread.
+ * @remarks This is only reached when no WindowController has made its metrics current.
+ */
+static void captureMetrics(WindowMetrics *metrics) {
+
+	metrics->window = _deque ? NULL : SDL_GL_GetCurrentWindow();
+	if (metrics->window) {
+
+		SDL_GetWindowSize(metrics->window, &metrics->size.w, &metrics->size.h);
+		SDL_GL_GetDrawableSize(metrics->window, &metrics->drawableSize.w, &metrics->drawableSize.h);
+
+		if (metrics->size.h && metrics->drawableSize.h) {
+			metrics->scale = metrics->drawableSize.h / (double) metrics->size.h;
+		} else {
+			metrics->scale = 1.0;
+		}
+	}
+}
+
+/**
+ * @return The deque of the calling thread within the given workers.
+ */
+static LayoutQueueDeque *ownDeque(LayoutQueueWorkers *workers) {
+
+	if (_deque && _deque->workers == workers) {
+		return _deque;
+	}
+
+	return &workers->deques[workers->numberOfThreads];
+}
+
+/**
+ * @brief Pushes the given job onto the tail of the given deque.
+ */
+static void pushJob(LayoutQueueDeque *deque, LayoutQueueJob *job) {
+
+	SDL_LockMutex(deque->lock);
+
+	if (deque->tail == deque->capacity) {
+		if (deque->head) {
+			memmove(deque->jobs, deque->jobs + deque->head, (deque->tail - deque->head) * sizeof(LayoutQueueJob *));
+			deque->tail -= deque->head;
+			deque->head = 0;
+		} else {
+			deque->capacity = deque->capacity ? deque->capacity << 1 : 64;
+			deque->jobs = realloc(deque->jobs, deque->capacity * sizeof(LayoutQueueJob *));
+			assert(deque->jobs);
+		}
+	}
+
+	deque->jobs[deque->tail++] = job;
+
+	SDL_UnlockMutex(deque->lock);
+}
+
+/**
+ * @brief Pops the newest job from the tail of the given deque, or steals the oldest from its head.
+ * @return The job, or `NULL` if the deque is empty.
+ */
+static LayoutQueueJob *takeJobFromDeque(LayoutQueueDeque *deque, _Bool steal) {
+
+	LayoutQueueJob *job = NULL;
+
+	SDL_LockMutex(deque->lock);
+
+	if (deque->tail > deque->head) {
+		job = steal ? deque->jobs[deque->head++] : deque->jobs[--deque->tail];
+
+		if (deque->head == deque->tail) {
+			deque->head = deque->tail = 0;
+		}
+	}
+
+	SDL_UnlockMutex(deque->lock);
+
+	return job;
+}
+
+/**
+ * @brief Takes a job from the given deque, or steals one from the other deques of `workers`.
+ * @return The job, or `NULL` if no jobs are pending.
+ */
+static LayoutQueueJob *takeJob(LayoutQueueWorkers *workers, LayoutQueueDeque *deque) {
+
+	LayoutQueueJob *job = takeJobFromDeque(deque, false);
+
+	if (job == NULL) {
+		const int count = workers->numberOfThreads + 1;
+		const int index = (int) (deque - workers->deques);
+
+		for (int i = 1; i < count && job == NULL; i++) {
+			job = takeJobFromDeque(&workers->deques[(index + i) % count], true);
+		}
+	}
+
+	if (job) {
+		SDL_AtomicAdd(&workers->pending, -1);
+	}
+
+	return job;
+}
+
+/**
+ * @brief Runs the given job on the calling thread, and signals its completion.
+ */
+static void runJob(LayoutQueueWorkers *workers, LayoutQueueJob *job) {
+
+	const WindowMetrics *metrics = $$(WindowController, makeMetricsCurrent, job->metrics.window ? &job->metrics : NULL);
+
+	$(job->view, layoutIfNeeded);
+
+	$$(WindowController, makeMetricsCurrent, metrics);
+
+	SDL_LockMutex(workers->lock);
+
+	SDL_AtomicSet(&job->done, 1);
+
+	SDL_CondBroadcast(workers->completed);
+	SDL_UnlockMutex(workers->lock);
+}
+
+/**
+ * @brief The worker thread, which runs and steals jobs until asked to quit.
+ */
+static int workerThread(void *data) {
+
+	_deque = data;
+
+	LayoutQueueWorkers *workers = _deque->workers;
+
+	while (true) {
+
+		LayoutQueueJob *job = takeJob(workers, _deque);
+		if (job) {
+			runJob(workers, job);
+			continue;
+		}
+
+		SDL_LockMutex(workers->lock);
+
+		while (SDL_AtomicGet(&workers->pending) == 0 && workers->quit == false) {
+			SDL_CondWait(workers->condition, workers->lock);
+		}
+
+		const _Bool quit = workers->quit;
+
+		SDL_UnlockMutex(workers->lock);
+
+		if (quit) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	LayoutQueue *this = (LayoutQueue *) self;
+
+	LayoutQueueWorkers *workers = this->workers;
+
+	SDL_LockMutex(workers->lock);
+
+	workers->quit = true;
+
+	SDL_CondBroadcast(workers->condition);
+	SDL_UnlockMutex(workers->lock);
+
+	for (int i = 0; i < workers->numberOfThreads; i++) {
+		SDL_WaitThread(workers->threads[i], NULL);
+	}
+
+	for (int i = 0; i <= workers->numberOfThreads; i++) {
+		free(workers->deques[i].jobs);
+		SDL_DestroyMutex(workers->deques[i].lock);
+	}
+
+	SDL_DestroyCond(workers->completed);
+	SDL_DestroyCond(workers->condition);
+	SDL_DestroyMutex(workers->lock);
+
+	free(workers);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - LayoutQueue
+
+/**
+ * @fn SDL_Window *LayoutQueue::currentWindow(void)
+ * @memberof LayoutQueue
+ */
+static SDL_Window *currentWindow(void) {
+
+	const WindowMetrics *metrics = $$(WindowController, currentMetrics);
+	if (metrics) {
+		return metrics->window;
+	}
+
+	return NULL;
+}
+
+/**
+ * @fn LayoutQueueJob *LayoutQueue::dispatch(LayoutQueue *self, View *view)
+ * @memberof LayoutQueue
+ */
+static LayoutQueueJob *dispatch(LayoutQueue *self, View *view) {
+
+	assert(view);
+
+	LayoutQueueJob *job = calloc(1, sizeof(LayoutQueueJob));
+	assert(job);
+
+	job->view = view;
+
+	const WindowMetrics *metrics = $$(WindowController, currentMetrics);
+	if (metrics) {
+		job->metrics = *metrics;
+	} else {
+		captureMetrics(&job->metrics);
+	}
+
+	LayoutQueueWorkers *workers = self->workers;
+
+	SDL_AtomicAdd(&workers->pending, 1);
+
+	pushJob(ownDeque(workers), job);
+
+	SDL_LockMutex(workers->lock);
+	SDL_CondSignal(workers->condition);
+	SDL_UnlockMutex(workers->lock);
+
+	return job;
+}
+
+/**
+ * @fn LayoutQueue *LayoutQueue::initWithThreads(LayoutQueue *self, int numberOfThreads)
+ * @memberof LayoutQueue
+ */
+static LayoutQueue *initWithThreads(LayoutQueue *self, int numberOfThreads) {
+
+	self = (LayoutQueue *) super(Object, self, init);
+	if (self) {
+
+		LayoutQueueWorkers *workers = self->workers = calloc(1, sizeof(LayoutQueueWorkers));
+		assert(workers);
+
+		workers->lock = SDL_CreateMutex();
+		assert(workers->lock);
+
+		workers->condition = SDL_CreateCond();
+		assert(workers->condition);
+
+		workers->completed = SDL_CreateCond();
+		assert(workers->completed);
+
+		workers->numberOfThreads = clamp(numberOfThreads ?: SDL_GetCPUCount() - 1, 1, MAX_LAYOUT_QUEUE_THREADS);
+
+		for (int i = 0; i <= workers->numberOfThreads; i++) {
+			workers->deques[i].lock = SDL_CreateMutex();
+			assert(workers->deques[i].lock);
+
+			workers->deques[i].workers = workers;
+		}
+
+		for (int i = 0; i < workers->numberOfThreads; i++) {
+			workers->threads[i] = SDL_CreateThread(workerThread, "LayoutQueue", &workers->deques[i]);
+			assert(workers->threads[i]);
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @fn void LayoutQueue::waitForJob(LayoutQueue *self, LayoutQueueJob *job)
+ * @memberof LayoutQueue
+ */
+static void waitForJob(LayoutQueue *self, LayoutQueueJob *job) {
+
+	assert(job);
+
+	LayoutQueueWorkers *workers = self->workers;
+	LayoutQueueDeque *deque = ownDeque(workers);
+
+	while (SDL_AtomicGet(&job->done) == 0) {
+
+		LayoutQueueJob *other = takeJob(workers, deque);
+		if (other) {
+			runJob(workers, other);
+			continue;
+		}
+
+		SDL_LockMutex(workers->lock);
+
+		while (SDL_AtomicGet(&job->done) == 0 && SDL_AtomicGet(&workers->pending) == 0) {
+			SDL_CondWait(workers->completed, workers->lock);
+		}
+
+		SDL_UnlockMutex(workers->lock);
+	}
+
+	free(job);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
+
+	((LayoutQueueInterface *) clazz->def->interface)->currentWindow = currentWindow;
+	((LayoutQueueInterface *) clazz->def->interface)->dispatch = dispatch;
+	((LayoutQueueInterface *) clazz->def->interface)->initWithThreads = initWithThreads;
+	((LayoutQueueInterface *) clazz->def->interface)->waitForJob = waitForJob;
+}
+
+/**
+ * @fn Class *LayoutQueue::_LayoutQueue(void)
+ * @memberof LayoutQueue
+ */
+Class *_LayoutQueue(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "LayoutQueue";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(LayoutQueue);
+		clazz.interfaceOffset = offsetof(LayoutQueue, interface);
+		clazz.interfaceSize = sizeof(LayoutQueueInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,134 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/Object.h>
+
+#include <ObjectivelyMVC/Types.h>
+
+/**
+ * @file
+ * @brief The LayoutQueue type.
+ */
+
+#define MAX_LAYOUT_QUEUE_THREADS 8
+
+typedef struct LayoutQueueJob LayoutQueueJob;
+typedef struct LayoutQueueWorkers LayoutQueueWorkers;
+
+typedef struct LayoutQueue LayoutQueue;
+typedef struct LayoutQueueInterface LayoutQueueInterface;
+
+/**
+ * @brief LayoutQueues lay out independent View subtrees concurrently on a pool of worker threads.
+ * @details When a LayoutQueue is installed with View::setLayoutQueue, the View traversal dispatches
+ * each subview that has `concurrentLayout` set and needs layout, once its superview's
+ * `layoutSubviews` has assigned its frame. The traversal joins each job before drawing its subtree,
+ * so drawing, and everything else that touches OpenGL, remains on the calling thread.
+ * @details Each worker owns a deque of jobs. Workers run their own jobs most recent first, and steal
+ * the oldest jobs of other workers when idle. Threads waiting on a job run pending jobs meanwhile.
+ * @extends Object
+ */
+struct LayoutQueue {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Object object;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	LayoutQueueInterface *interface;
+
+	/**
+	 * @brief The worker threads and their jobs.
+	 * @private
+	 */
+	LayoutQueueWorkers *workers;
+};
+
+/**
+ * @brief The LayoutQueue interface.
+ */
+struct LayoutQueueInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @static
+	 * @fn SDL_Window *LayoutQueue::currentWindow(void)
+	 * @return The window of the job running on the calling thread, or `NULL`.
+	 * @remarks Worker threads have no current OpenGL context, and must not query SDL windows, so
+	 * jobs carry a snapshot of the window metrics of the thread that dispatched them.
+	 * @see WindowController::currentMetrics(void)
+	 * @memberof LayoutQueue
+	 */
+	SDL_Window *(*currentWindow)(void);
+
+	/**
+	 * @fn LayoutQueueJob *LayoutQueue::dispatch(LayoutQueue *self, View *view)
+	 * @brief Dispatches layout of the subtree rooted at the given View.
+	 * @param self The LayoutQueue.
+	 * @param view The View.
+	 * @return The job, which must be passed to LayoutQueue::waitForJob.
+	 * @remarks The subtree must share no mutable state with the rest of the hierarchy until the job
+	 * has been waited on.
+	 * @memberof LayoutQueue
+	 */
+	LayoutQueueJob *(*dispatch)(LayoutQueue *self, View *view);
+
+	/**
+	 * @fn LayoutQueue *LayoutQueue::initWithThreads(LayoutQueue *self, int numberOfThreads)
+	 * @brief Initializes this LayoutQueue.
+	 * @param self The LayoutQueue.
+	 * @param numberOfThreads The count of worker threads, or `0` for one fewer than the count of CPUs.
+	 * @return The initialized LayoutQueue, or `NULL` on error.
+	 * @memberof LayoutQueue
+	 */
+	LayoutQueue *(*initWithThreads)(LayoutQueue *self, int numberOfThreads);
+
+	/**
+	 * @fn void LayoutQueue::waitForJob(LayoutQueue *self, LayoutQueueJob *job)
+	 * @brief Waits for the given job to complete, and frees it.
+	 * @param self The LayoutQueue.
+	 * @param job The job.
+	 * @remarks The calling thread runs pending jobs while it waits.
+	 * @memberof LayoutQueue
+	 */
+	void (*waitForJob)(LayoutQueue *self, LayoutQueueJob *job);
+};
+
+/**
+ * @fn Class *LayoutQueue::_LayoutQueue(void)
+ * @brief The LayoutQueue archetype.
+ * @return The LayoutQueue Class.
+ * @memberof LayoutQueue
+ */
+OBJECTIVELYMVC_EXPORT Class *_LayoutQueue(void);
@@ -125,27 +125,26 @@ static void layoutSubviews(View *self) {
  */
 static _Bool controlReceivedEvent(const View *view, const SDL_Event *event) {
 
-	_Bool received = false;
-	Array *subviews = $(view, visibleSubviews);
+	const Array *subviews = (Array *) view->subviews;
+	for (size_t i = 0; subviews && i < subviews->count; i++) {
 
-	for (size_t i = 0; i < subviews->count; i++) {
+		const View *subview = $(subviews, objectAtIndex, i);
+		if (subview->hidden || subview->alignment == ViewAlignmentInternal) {
+			continue;
+		}
 
-		View *subview = $(subviews, objectAtIndex, i);
 		if (controlReceivedEvent(subview, event)) {
-			received = true;
-			break;
+			return true;
 		}
 
 		if ($((Object *) subview, isKindOfClass, _Control())) {
 			if ($(subview, didReceiveEvent, event)) {
-				received = true;
-				break;
+				return true;
 			}
 		}
 	}
 
-	release(subviews);
-	return received;
+	return false;
 }
 
 /**
@@ -22,13 +22,302 @@
  */
 
 #include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define RENDERER_SSE41
+#include <smmintrin.h>
+#endif
 
 #include <ObjectivelyMVC/Log.h>
 #include <ObjectivelyMVC/Renderer.h>
 #include <ObjectivelyMVC/View.h>
+#include <ObjectivelyMVC/WindowController.h>
 
 #define _Class _Renderer
 
+#define RENDERER_GLYPHS_FIRST ' '
+#define RENDERER_GLYPHS_COUNT ('~' - ' ' + 1)
+
+#define RENDERER_UNBOUNDED MakeRect(-(INT_MAX / 2), -(INT_MAX / 2), INT_MAX, INT_MAX)
+
+/**
+ * @brief A View added for the current frame, with its resolved geometry.
+ */
+typedef struct {
+
+	/**
+	 * @brief The View.
+	 */
+	View *view;
+
+	/**
+	 * @brief The origin of the View's render frame.
+	 */
+	SDL_Point origin;
+
+	/**
+	 * @brief The clipping frame of the View.
+	 */
+	SDL_Rect clippingFrame;
+
+	/**
+	 * @brief The rectangle that clips the View's subviews.
+	 */
+	SDL_Rect bounds;
+
+	/**
+	 * @brief The depth of the View.
+	 */
+	int depth;
+
+	/**
+	 * @brief The order in which the View was added.
+	 */
+	size_t index;
+} RendererFrameEntry;
+
+/**
+ * @brief The Views to be drawn each frame.
+ * @details Views are resolved into entries as they are added, in hierarchy order. Once sorted by
+ * depth, the clipping frames are mirrored into a structure of arrays, so that culling is a batch
+ * operation over contiguous memory. The frame is emptied once rendered, so that it never refers
+ * to Views beyond the frame in which they were added.
+ */
+struct RendererFrame {
+
+	/**
+	 * @brief The entries, in the order they were added.
+	 */
+	RendererFrameEntry *entries;
+
+	/**
+	 * @brief The entry indexes of the Views being added, from the root to the most recent.
+	 */
+	size_t *stack;
+
+	/**
+	 * @brief The depth of the stack.
+	 */
+	size_t stackDepth;
+
+	/**
+	 * @brief The Views, in draw order.
+	 */
+	View **views;
+
+	/**
+	 * @brief The clipping frames, in draw order.
+	 */
+	int *x, *y, *w, *h;
+
+	/**
+	 * @brief Nonzero for each View that is visible in the window.
+	 */
+	Uint8 *visible;
+
+	/**
+	 * @brief The number of Views.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The capacity of the arrays.
+	 */
+	size_t capacity;
+};
+
+/**
+ * @brief Culls the given rectangles against `rect`, writing their visibility to `visible`.
+ */
+typedef void (*RendererCullFunction)(const int *x, const int *y, const int *w, const int *h, size_t count, const SDL_Rect *rect, Uint8 *visible);
+
+static RendererCullFunction _cull;
+
+/**
+ * @brief The printable ASCII glyph textures of a Font.
+ */
+struct RendererGlyphs {
+
+	/**
+	 * @brief The Font.
+	 */
+	Font *font;
+
+	/**
+	 * @brief The glyph textures.
+	 */
+	GLuint textures[RENDERER_GLYPHS_COUNT];
+
+	/**
+	 * @brief The glyph sizes, in points rather than pixels.
+	 */
+	SDL_Size sizes[RENDERER_GLYPHS_COUNT];
+
+	/**
+	 * @brief The next RendererGlyphs.
+	 */
+	RendererGlyphs *next;
+};
+
+/**
+ * @brief Frees all glyphs, optionally deleting their textures.
+ */
+static void freeGlyphs(Renderer *self, _Bool deleteTextures) {
+
+	RendererGlyphs *glyphs = self->glyphs;
+	while (glyphs) {
+
+		RendererGlyphs *next = glyphs->next;
+
+		if (deleteTextures) {
+			glDeleteTextures(RENDERER_GLYPHS_COUNT, glyphs->textures);
+		}
+
+		release(glyphs->font);
+		free(glyphs);
+
+		glyphs = next;
+	}
+
+	self->glyphs = NULL;
+}
+
+/**
+ * @brief Frees the given RendererFrame.
+ */
+static void freeFrame(RendererFrame *frame) {
+
+	free(frame->entries);
+	free(frame->stack);
+	free(frame->views);
+	free(frame->x);
+	free(frame->y);
+	free(frame->w);
+	free(frame->h);
+	free(frame->visible);
+
+	free(frame);
+}
+
+/**
+ * @brief Ensures the given RendererFrame can hold at least `count` Views.
+ */
+static void reserveFrame(RendererFrame *frame, size_t count) {
+
+	if (count <= frame->capacity) {
+		return;
+	}
+
+	size_t capacity = frame->capacity ?: 64;
+	while (capacity < count) {
+		capacity <<= 1;
+	}
+
+	frame->entries = realloc(frame->entries, capacity * sizeof(RendererFrameEntry));
+	frame->stack = realloc(frame->stack, capacity * sizeof(size_t));
+	frame->views = realloc(frame->views, capacity * sizeof(View *));
+	frame->x = realloc(frame->x, capacity * sizeof(int));
+	frame->y = realloc(frame->y, capacity * sizeof(int));
+	frame->w = realloc(frame->w, capacity * sizeof(int));
+	frame->h = realloc(frame->h, capacity * sizeof(int));
+	frame->visible = realloc(frame->visible, capacity * sizeof(Uint8));
+
+	assert(frame->entries && frame->stack && frame->views);
+	assert(frame->x && frame->y && frame->w && frame->h && frame->visible);
+
+	frame->capacity = capacity;
+}
+
+/**
+ * @brief RendererCullFunction in plain C.
+ */
+static void cull_scalar(const int *x, const int *y, const int *w, const int *h, size_t count, const SDL_Rect *rect, Uint8 *visible) {
+
+	const int rx1 = rect->x + rect->w, ry1 = rect->y + rect->h;
+
+	for (size_t i = 0; i < count; i++) {
+
+		const int x0 = max(x[i], rect->x), x1 = min(x[i] + w[i], rx1);
+		const int y0 = max(y[i], rect->y), y1 = min(y[i] + h[i], ry1);
+
+		visible[i] = x0 < x1 && y0 < y1;
+	}
+}
+
+#if defined(RENDERER_SSE41)
+
+/**
+ * @brief RendererCullFunction for SSE4.1, four rectangles at a time.
+ */
+__attribute__((target("sse4.1")))
+static void cull_sse41(const int *x, const int *y, const int *w, const int *h, size_t count, const SDL_Rect *rect, Uint8 *visible) {
+
+	const __m128i rx0 = _mm_set1_epi32(rect->x), rx1 = _mm_set1_epi32(rect->x + rect->w);
+	const __m128i ry0 = _mm_set1_epi32(rect->y), ry1 = _mm_set1_epi32(rect->y + rect->h);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+
+		const __m128i x0 = _mm_loadu_si128((const __m128i *) (x + i));
+		const __m128i y0 = _mm_loadu_si128((const __m128i *) (y + i));
+		const __m128i x1 = _mm_add_epi32(x0, _mm_loadu_si128((const __m128i *) (w + i)));
+		const __m128i y1 = _mm_add_epi32(y0, _mm_loadu_si128((const __m128i *) (h + i)));
+
+		const __m128i ix = _mm_cmplt_epi32(_mm_max_epi32(x0, rx0), _mm_min_epi32(x1, rx1));
+		const __m128i iy = _mm_cmplt_epi32(_mm_max_epi32(y0, ry0), _mm_min_epi32(y1, ry1));
+
+		const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(ix, iy)));
+
+		visible[i + 0] = (mask >> 0) & 1;
+		visible[i + 1] = (mask >> 1) & 1;
+		visible[i + 2] = (mask >> 2) & 1;
+		visible[i + 3] = (mask >> 3) & 1;
+	}
+
+	cull_scalar(x + i, y + i, w + i, h + i, count - i, rect, visible + i);
+}
+
+#endif
+
+/**
+ * @brief Resolves the geometry of the given View when its superview was not added before it.
+ */
+static void resolveEntry(RendererFrameEntry *entry) {
+
+	const View *view = entry->view;
+
+	const SDL_Rect renderFrame = $(view, renderFrame);
+
+	entry->origin = MakePoint(renderFrame.x, renderFrame.y);
+	entry->clippingFrame = $(view, clippingFrame);
+	entry->depth = $(view, depth);
+
+	entry->bounds = RENDERER_UNBOUNDED;
+	for (const View *v = view; v; v = v->superview) {
+		if (v->clipsSubviews) {
+			entry->bounds = v == view ? entry->clippingFrame : $(v, clippingFrame);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Comparator for sorting RendererFrameEntries by depth (Painter's Algorithm).
+ * @remarks Views of equal depth are drawn in the order they were added.
+ */
+static int compareEntries(const void *a, const void *b) {
+
+	const RendererFrameEntry *e1 = a, *e2 = b;
+
+	if (e1->depth != e2->depth) {
+		return e1->depth < e2->depth ? -1 : 1;
+	}
+
+	return e1->index < e2->index ? -1 : e1->index > e2->index;
+}
+
 #pragma mark - Object
 
 /**
@@ -38,7 +327,9 @@ static void dealloc(Object *self) {
 
 	Renderer *this = (Renderer *) self;
 
-	release(this->views);
+	freeFrame(this->frame);
+
+	freeGlyphs(this, true);
 
 	super(Object, self, dealloc);
 }
@@ -50,7 +341,56 @@ static void dealloc(Object *self) {
  * @memberof Renderer
  */
 static void addView(Renderer *self, View *view) {
-	$(self->views, addObject, view);
+
+	assert(view);
+
+	RendererFrame *frame = self->frame;
+
+	reserveFrame(frame, frame->count + 1);
+
+	RendererFrameEntry *entry = &frame->entries[frame->count];
+
+	entry->view = view;
+	entry->index = frame->count;
+
+	while (frame->stackDepth && frame->entries[frame->stack[frame->stackDepth - 1]].view != view->superview) {
+		frame->stackDepth--;
+	}
+
+	if (frame->stackDepth) {
+
+		const RendererFrameEntry *parent = &frame->entries[frame->stack[frame->stackDepth - 1]];
+		const View *superview = parent->view;
+
+		entry->origin.x = parent->origin.x + view->frame.x;
+		entry->origin.y = parent->origin.y + view->frame.y;
+
+		if (view->alignment != ViewAlignmentInternal) {
+			entry->origin.x += superview->padding.left;
+			entry->origin.y += superview->padding.top;
+		}
+
+		SDL_Rect rect = MakeRect(entry->origin.x, entry->origin.y, view->frame.w, view->frame.h);
+
+		if (view->borderWidth && view->borderColor.a) {
+			rect.x -= view->borderWidth;
+			rect.y -= view->borderWidth;
+			rect.w += view->borderWidth * 2;
+			rect.h += view->borderWidth * 2;
+		}
+
+		if (SDL_IntersectRect(&parent->bounds, &rect, &entry->clippingFrame) == false) {
+			entry->clippingFrame.w = entry->clippingFrame.h = 0;
+		}
+
+		entry->bounds = view->clipsSubviews ? entry->clippingFrame : parent->bounds;
+		entry->depth = view->zIndex + parent->depth + 1;
+
+	} else {
+		resolveEntry(entry);
+	}
+
+	frame->stack[frame->stackDepth++] = frame->count++;
 }
 
 /**
@@ -108,6 +448,88 @@ static GLuint createTexture(const Renderer *self, const SDL_Surface *surface) {
 	return texture;
 }
 
+/**
+ * @return The RendererGlyphs for the given Font, rendering them if necessary.
+ * @remarks Fonts are opened at their point size times the window scale, so the glyph textures are
+ * sized in pixels, while the glyph sizes are taken from Font::sizeCharacters, in points.
+ */
+static RendererGlyphs *drawCharacters_glyphs(Renderer *self, Font *font) {
+
+	for (RendererGlyphs *glyphs = self->glyphs; glyphs; glyphs = glyphs->next) {
+		if (glyphs->font == font) {
+			return glyphs;
+		}
+	}
+
+	RendererGlyphs *glyphs = calloc(1, sizeof(RendererGlyphs));
+	assert(glyphs);
+
+	glyphs->font = retain(font);
+
+	for (int i = 0; i < RENDERER_GLYPHS_COUNT; i++) {
+
+		const char chars[] = { RENDERER_GLYPHS_FIRST + i, '\0' };
+
+		SDL_Surface *surface = $(font, renderCharacters, chars, Colors.White);
+		if (surface) {
+			glyphs->textures[i] = $(self, createTexture, surface);
+			SDL_FreeSurface(surface);
+		}
+
+		$(font, sizeCharacters, chars, &glyphs->sizes[i].w, &glyphs->sizes[i].h);
+	}
+
+	glyphs->next = self->glyphs;
+	self->glyphs = glyphs;
+
+	return glyphs;
+}
+
+/**
+ * @return The glyph index of the given character, substituting `?` for unprintable characters.
+ */
+static int drawCharacters_index(unsigned char c) {
+
+	if (c < RENDERER_GLYPHS_FIRST || c >= RENDERER_GLYPHS_FIRST + RENDERER_GLYPHS_COUNT) {
+		c = '?';
+	}
+
+	return c - RENDERER_GLYPHS_FIRST;
+}
+
+/**
+ * @fn void Renderer::drawCharacters(Renderer *self, Font *font, const char *chars, const SDL_Point *origin)
+ * @memberof Renderer
+ */
+static void drawCharacters(Renderer *self, Font *font, const char *chars, const SDL_Point *origin) {
+
+	assert(font);
+	assert(chars);
+	assert(origin);
+
+	const RendererGlyphs *glyphs = drawCharacters_glyphs(self, font);
+
+	int x = origin->x;
+
+	for (const unsigned char *c = (const unsigned char *) chars; *c; c++) {
+
+		if ((*c & 0xc0) == 0x80) {
+			continue;
+		}
+
+		const int i = drawCharacters_index(*c);
+
+		const SDL_Size *size = &glyphs->sizes[i];
+
+		if (glyphs->textures[i]) {
+			const SDL_Rect rect = MakeRect(x, origin->y, size->w, size->h);
+			$(self, drawTexture, glyphs->textures[i], &rect);
+		}
+
+		x += size->w;
+	}
+}
+
 /**
  * @fn void Renderer::drawLine(const Renderer *self, const SDL_Point *points)
  * @memberof Renderer
@@ -241,53 +663,74 @@ static Renderer *init(Renderer *self) {
 
 	self = (Renderer *) super(Object, self, init);
 	if (self) {
-		self->views = $$(MutableArray, array);
-		assert(self->views);
+		self->frame = calloc(1, sizeof(RendererFrame));
+		assert(self->frame);
 	}
 
 	return self;
 }
 
 /**
- * @brief Comparator for sorting Views by depth (Painter's Algorithm).
+ * @fn void Renderer::render(Renderer *self)
+ * @memberof Renderer
  */
-static Order render_sort(const ident a, const ident b) {
+static void render(Renderer *self) {
 
-	const int depthA = $((const View *) a, depth);
-	const int depthB = $((const View *) b, depth);
+	RendererFrame *frame = self->frame;
 
-	return (Order) depthA - depthB;
-}
+	size_t count = 0;
+	for (size_t i = 0; i < frame->count; i++) {
 
-/**
- * @brief ArrayEnumerator for rendering Views.
- */
-static void render_renderView(const Array *array, ident obj, ident data) {
+		const RendererFrameEntry *entry = &frame->entries[i];
+		if (entry->clippingFrame.w > 0 && entry->clippingFrame.h > 0) {
+			frame->entries[count++] = *entry;
+		}
+	}
 
-	View *view = (View *) obj;
+	frame->count = count;
 
-	Renderer *renderer = (Renderer *) data;
+	qsort(frame->entries, frame->count, sizeof(RendererFrameEntry), compareEntries);
 
-	const SDL_Rect clippingFrame = $(view, clippingFrame);
-	if (clippingFrame.w && clippingFrame.h) {
+	for (size_t i = 0; i < frame->count; i++) {
 
-		$(renderer, setClippingFrame, &clippingFrame);
+		const RendererFrameEntry *entry = &frame->entries[i];
 
-		$(view, render, renderer);
+		frame->views[i] = entry->view;
+		frame->x[i] = entry->clippingFrame.x;
+		frame->y[i] = entry->clippingFrame.y;
+		frame->w[i] = entry->clippingFrame.w;
+		frame->h[i] = entry->clippingFrame.h;
 	}
-}
 
-/**
- * @fn void Renderer::drawViews(Renderer *self)
- * @memberof Renderer
- */
-static void render(Renderer *self) {
+	SDL_Rect viewport = MakeRect(0, 0, 0, 0);
+	const WindowMetrics *metrics = $$(WindowController, currentMetrics);
+	if (metrics) {
+		viewport.w = metrics->size.w;
+		viewport.h = metrics->size.h;
+	} else {
+		SDL_Window *window = SDL_GL_GetCurrentWindow();
+		if (window) {
+			SDL_GetWindowSize(window, &viewport.w, &viewport.h);
+		} else {
+			viewport = RENDERER_UNBOUNDED;
+		}
+	}
+
+	_cull(frame->x, frame->y, frame->w, frame->h, frame->count, &viewport, frame->visible);
 
-	$(self->views, sort, render_sort);
+	for (size_t i = 0; i < frame->count; i++) {
+		if (frame->visible[i]) {
 
-	$((Array *) self->views, enumerateObjects, render_renderView, self);
+			const SDL_Rect clippingFrame = MakeRect(frame->x[i], frame->y[i], frame->w[i], frame->h[i]);
 
-	$(self->views, removeAllObjects);
+			$(self, setClippingFrame, &clippingFrame);
+
+			$(frame->views[i], render, self);
+		}
+	}
+
+	frame->count = 0;
+	frame->stackDepth = 0;
 }
 
 /**
@@ -296,6 +739,7 @@ static void render(Renderer *self) {
  */
 static void renderDeviceDidReset(Renderer *self) {
 
+	freeGlyphs(self, false);
 }
 
 /**
@@ -304,17 +748,22 @@ static void renderDeviceDidReset(Renderer *self) {
  */
 static void setClippingFrame(Renderer *self, const SDL_Rect *clippingFrame) {
 
-	SDL_Window *window = SDL_GL_GetCurrentWindow();
-
 	SDL_Rect rect;
 	if (clippingFrame) {
 		rect = *clippingFrame;
 	} else {
 		rect = MakeRect(0, 0, 0, 0);
-		SDL_GL_GetDrawableSize(window, &rect.w, &rect.h);
+
+		const WindowMetrics *metrics = $$(WindowController, currentMetrics);
+		if (metrics) {
+			rect.w = metrics->drawableSize.w;
+			rect.h = metrics->drawableSize.h;
+		} else {
+			SDL_GL_GetDrawableSize(SDL_GL_GetCurrentWindow(), &rect.w, &rect.h);
+		}
 	}
 
-	const SDL_Rect scissor = MVC_TransformToWindow(window, &rect);
+	const SDL_Rect scissor = MVC_TransformToWindow(NULL, &rect);
 
 	glScissor(scissor.x - 1, scissor.y - 1, scissor.w + 1, scissor.h + 1);
 }
@@ -327,6 +776,34 @@ static void setDrawColor(Renderer *self, const SDL_Color *color) {
 	glColor4ubv((const GLubyte *) color);
 }
 
+/**
+ * @fn SDL_Size Renderer::sizeCharacters(Renderer *self, Font *font, const char *chars)
+ * @memberof Renderer
+ */
+static SDL_Size sizeCharacters(Renderer *self, Font *font, const char *chars) {
+
+	assert(font);
+	assert(chars);
+
+	const RendererGlyphs *glyphs = drawCharacters_glyphs(self, font);
+
+	SDL_Size size = MakeSize(0, 0);
+
+	for (const unsigned char *c = (const unsigned char *) chars; *c; c++) {
+
+		if ((*c & 0xc0) == 0x80) {
+			continue;
+		}
+
+		const SDL_Size *glyph = &glyphs->sizes[drawCharacters_index(*c)];
+
+		size.w += glyph->w;
+		size.h = max(size.h, glyph->h);
+	}
+
+	return size;
+}
+
 #pragma mark - Class lifecycle
 
 /**
@@ -339,6 +816,7 @@ static void initialize(Class *clazz) {
 	((RendererInterface *) clazz->def->interface)->addView = addView;
 	((RendererInterface *) clazz->def->interface)->beginFrame = beginFrame;
 	((RendererInterface *) clazz->def->interface)->createTexture = createTexture;
+	((RendererInterface *) clazz->def->interface)->drawCharacters = drawCharacters;
 	((RendererInterface *) clazz->def->interface)->drawLine = drawLine;
 	((RendererInterface *) clazz->def->interface)->drawLines = drawLines;
 	((RendererInterface *) clazz->def->interface)->drawRect = drawRect;
@@ -350,6 +828,15 @@ static void initialize(Class *clazz) {
 	((RendererInterface *) clazz->def->interface)->renderDeviceDidReset = renderDeviceDidReset;
 	((RendererInterface *) clazz->def->interface)->setClippingFrame = setClippingFrame;
 	((RendererInterface *) clazz->def->interface)->setDrawColor = setDrawColor;
+	((RendererInterface *) clazz->def->interface)->sizeCharacters = sizeCharacters;
+
+	_cull = cull_scalar;
+
+#if defined(RENDERER_SSE41)
+	if (SDL_HasSSE41()) {
+		_cull = cull_sse41;
+	}
+#endif
 }
 
 /**
@@ -27,6 +27,7 @@
 
 #include <Objectively/MutableArray.h>
 
+#include <ObjectivelyMVC/Font.h>
 #include <ObjectivelyMVC/Types.h>
 
 /**
@@ -40,6 +41,9 @@
 typedef struct Renderer Renderer;
 typedef struct RendererInterface RendererInterface;
 
+typedef struct RendererFrame RendererFrame;
+typedef struct RendererGlyphs RendererGlyphs;
+
 /**
  * @brief The Renderer is responsible for rasterizing the View hierarchy of a WindowController.
  * @details This class provides an OpenGL 1.x implementation of the RendererInterface. Applications
@@ -61,9 +65,20 @@ struct Renderer {
 	RendererInterface *interface;
 
 	/**
-	 * @brief The Views to be drawn each frame.
+	 * @brief The Views to be drawn each frame, and their geometry.
+	 * @remarks This replaces the public `MutableArray *views` of earlier versions, which is no
+	 * longer available. Subclasses and applications that appended to or enumerated `views` should
+	 * add Views with Renderer::addView(Renderer *, View *) instead, and should not inspect the
+	 * frame, which is emptied once it is rendered.
+	 * @private
+	 */
+	RendererFrame *frame;
+
+	/**
+	 * @brief The glyph textures of the Fonts used with drawCharacters.
+	 * @private
 	 */
-	MutableArray *views;
+	RendererGlyphs *glyphs;
 };
 
 /**
@@ -81,6 +96,8 @@ struct RendererInterface {
 	 * @brief Adds the View to the Renderer for the current frame.
 	 * @param self The Renderer.
 	 * @param view The View.
+	 * @remarks The clipping frame and depth of the View are resolved as it is added, from those of
+	 * its superview. Views are therefore expected to be added in hierarchy order, as View::draw does.
 	 * @memberof Renderer
 	 */
 	void (*addView)(Renderer *self, View *view);
@@ -105,6 +122,21 @@ struct RendererInterface {
 	 */
 	GLuint (*createTexture)(const Renderer *self, const SDL_Surface *surface);
 
+	/**
+	 * @fn void Renderer::drawCharacters(Renderer *self, Font *font, const char *chars, const SDL_Point *origin)
+	 * @brief Draws the given characters with the current draw color, without creating a texture
+	 * for them.
+	 * @param self The Renderer.
+	 * @param font The Font.
+	 * @param chars The null-terminated characters.
+	 * @param origin The top-left corner in screen coordinates.
+	 * @remarks The printable ASCII glyphs of each Font are rendered to textures once, and reused.
+	 * Other characters are drawn as `?`, and kerning is not applied, so this method is intended for
+	 * plain, data-heavy text such as table cells. Use Text for anything else.
+	 * @memberof Renderer
+	 */
+	void (*drawCharacters)(Renderer *self, Font *font, const char *chars, const SDL_Point *origin);
+
 	/**
 	 * @fn void Renderer::drawLine(const Renderer *self, const SDL_Point *points)
 	 * @brief Draws a line segment between two points using `GL_LINE_STRIP`.
@@ -206,6 +238,17 @@ struct RendererInterface {
 	 * @memberof Renderer
 	 */
 	void (*setDrawColor)(Renderer *self, const SDL_Color *color);
+
+	/**
+	 * @fn SDL_Size Renderer::sizeCharacters(Renderer *self, Font *font, const char *chars)
+	 * @brief Measures the given characters as Renderer::drawCharacters would draw them.
+	 * @param self The Renderer.
+	 * @param font The Font.
+	 * @param chars The null-terminated characters.
+	 * @return The size of the characters, in points.
+	 * @memberof Renderer
+	 */
+	SDL_Size (*sizeCharacters)(Renderer *self, Font *font, const char *chars);
 };
 
 /**
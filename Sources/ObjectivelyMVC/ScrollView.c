@@ -99,6 +99,7 @@ static ScrollView *initWithFrame(ScrollView *self, const SDL_Rect *frame, Contro
 	self = (ScrollView *) super(Control, self, initWithFrame, frame, style);
 	if (self) {
 		self->control.view.clipsSubviews = true;
+		self->control.view.defersLayoutDuringLiveResize = true;
 
 		if (style == ControlStyleDefault) {
 			self->control.view.padding.top = 0;
@@ -138,6 +139,10 @@ static void scrollToOffset(ScrollView *self, const SDL_Point *offset) {
 	}
 
 	self->control.view.needsLayout = true;
+
+	if (self->delegate.didScroll) {
+		self->delegate.didScroll(self);
+	}
 }
 
 /**
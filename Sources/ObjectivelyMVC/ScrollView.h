@@ -81,6 +81,11 @@ struct ScrollView {
 	 * @brief The content View.
 	 */
 	View *contentView;
+
+	/**
+	 * @brief The delegate.
+	 */
+	ScrollViewDelegate delegate;
 };
 
 /**
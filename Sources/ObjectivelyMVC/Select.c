@@ -22,14 +22,406 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
 
 #include <Objectively/Array.h>
 
 #include <ObjectivelyMVC/Text.h>
 #include <ObjectivelyMVC/Select.h>
 
+#define SELECT_INDEX_MIN_BUCKETS 16
+
+typedef struct SelectIndexEntry SelectIndexEntry;
+
+/**
+ * @brief An Option in the value index of a Select.
+ */
+struct SelectIndexEntry {
+
+	/**
+	 * @brief The Option.
+	 */
+	Option *option;
+
+	/**
+	 * @brief The next entry in the same bucket.
+	 */
+	SelectIndexEntry *next;
+};
+
+/**
+ * @brief The Options of a Select, hashed by value.
+ */
+struct SelectIndex {
+
+	/**
+	 * @brief The hash buckets, each of which lists its Options in the order they were added.
+	 */
+	SelectIndexEntry **buckets;
+
+	/**
+	 * @brief The count of `buckets`, which is a power of two.
+	 */
+	size_t numberOfBuckets;
+
+	/**
+	 * @brief The count of entries.
+	 */
+	size_t count;
+};
+
+/**
+ * @brief An Option title, for type-ahead.
+ */
+struct SelectTitle {
+
+	/**
+	 * @brief The title.
+	 */
+	const char *title;
+
+	/**
+	 * @brief The index of the Option.
+	 */
+	size_t index;
+};
+
 #define _Class _Select
 
+/**
+ * @return The bucket for the given value.
+ */
+static SelectIndexEntry **bucketForValue(const SelectIndex *index, const ident value) {
+
+	uint64_t hash = (uintptr_t) value;
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+
+	return index->buckets + (hash & (index->numberOfBuckets - 1));
+}
+
+/**
+ * @brief Appends the given entry to its bucket.
+ */
+static void linkEntry(SelectIndex *index, SelectIndexEntry *entry) {
+
+	SelectIndexEntry **e = bucketForValue(index, entry->option->value);
+	while (*e) {
+		e = &(*e)->next;
+	}
+
+	entry->next = NULL;
+	*e = entry;
+}
+
+/**
+ * @brief Adds the given Option to the value index, growing it as needed.
+ */
+static void indexOption(Select *self, Option *option) {
+
+	SelectIndex *index = self->index;
+
+	if (index->count >= index->numberOfBuckets) {
+
+		SelectIndexEntry **buckets = index->buckets;
+		const size_t numberOfBuckets = index->numberOfBuckets;
+
+		index->numberOfBuckets = max(numberOfBuckets * 2, SELECT_INDEX_MIN_BUCKETS);
+		index->buckets = calloc(index->numberOfBuckets, sizeof(SelectIndexEntry *));
+		assert(index->buckets);
+
+		for (size_t i = 0; i < numberOfBuckets; i++) {
+			SelectIndexEntry *entry = buckets[i];
+			while (entry) {
+				SelectIndexEntry *next = entry->next;
+				linkEntry(index, entry);
+				entry = next;
+			}
+		}
+
+		free(buckets);
+	}
+
+	SelectIndexEntry *entry = calloc(1, sizeof(SelectIndexEntry));
+	assert(entry);
+
+	entry->option = option;
+
+	linkEntry(index, entry);
+	index->count++;
+}
+
+/**
+ * @brief Removes the given Option from the value index.
+ */
+static void unindexOption(Select *self, const Option *option) {
+
+	SelectIndex *index = self->index;
+
+	if (index->count) {
+
+		SelectIndexEntry **e = bucketForValue(index, option->value);
+		while (*e) {
+			SelectIndexEntry *entry = *e;
+			if (entry->option == option) {
+				*e = entry->next;
+				free(entry);
+				index->count--;
+				break;
+			}
+			e = &entry->next;
+		}
+	}
+}
+
+/**
+ * @brief Removes all Options from the value index.
+ */
+static void unindexAllOptions(Select *self) {
+
+	SelectIndex *index = self->index;
+
+	for (size_t i = 0; i < index->numberOfBuckets; i++) {
+		SelectIndexEntry *entry = index->buckets[i];
+		while (entry) {
+			SelectIndexEntry *next = entry->next;
+			free(entry);
+			entry = next;
+		}
+		index->buckets[i] = NULL;
+	}
+
+	index->count = 0;
+}
+
+/**
+ * @brief Invalidates the displayed Options and the cached metrics of all Options.
+ */
+static void optionsDidChange(Select *self) {
+
+	free(self->titles);
+	self->titles = NULL;
+
+	self->optionHeight = -1;
+	self->optionWidth = -1;
+	self->visibleOptions.location = -1;
+
+	self->control.view.needsLayout = true;
+}
+
+/**
+ * @brief Measures the widest and the tallest Options, if necessary.
+ */
+static void measureOptions(Select *self) {
+
+	if (self->optionWidth < 0 || self->optionHeight < 0) {
+
+		self->optionWidth = self->optionHeight = 0;
+
+		const Array *options = (Array *) self->options;
+		for (size_t i = 0; i < options->count; i++) {
+
+			const View *option = (View *) $(options, objectAtIndex, i);
+
+			const SDL_Size optionSize = $(option, sizeThatFits);
+			self->optionWidth = max(self->optionWidth, optionSize.w);
+
+			const SDL_Size containedSize = $(option, sizeThatContains);
+			self->optionHeight = max(self->optionHeight, containedSize.h);
+		}
+	}
+}
+
+/**
+ * @brief Replaces the subviews of the StackView with the Options in the given range.
+ */
+static void displayOptions(Select *self, const Range range) {
+
+	if (range.location == self->visibleOptions.location && range.length == self->visibleOptions.length) {
+		return;
+	}
+
+	View *stackView = (View *) self->stackView;
+
+	$(stackView, removeAllSubviews);
+
+	const Array *options = (Array *) self->options;
+	for (size_t i = 0; i < range.length; i++) {
+
+		View *option = $(options, objectAtIndex, range.location + i);
+		option->hidden = false;
+
+		$(stackView, addSubview, option);
+	}
+
+	stackView->needsLayout = true;
+
+	self->visibleOptions = range;
+}
+
+/**
+ * @return The index of the selected Option, or `-1`.
+ */
+static ssize_t selectedIndex(const Select *self) {
+
+	if (self->selectedOption) {
+		return $((Array *) self->options, indexOfObject, self->selectedOption);
+	}
+
+	return -1;
+}
+
+/**
+ * @return The index of the displayed Option at the given point, or `-1`.
+ * @remarks Options are presented at the height of the tallest Option, so the index is computed
+ * from the offset of the point.
+ */
+static ssize_t optionIndexAtPoint(const Select *self, const SDL_Point *point) {
+
+	if (self->visibleOptions.location < 0 || self->visibleOptions.length == 0) {
+		return -1;
+	}
+
+	const View *stackView = (View *) self->stackView;
+
+	const SDL_Rect frame = $(stackView, renderFrame);
+	if (SDL_PointInRect(point, &frame) == false) {
+		return -1;
+	}
+
+	measureOptions((Select *) self);
+
+	if (self->optionHeight <= 0) {
+		return -1;
+	}
+
+	const int stride = self->optionHeight + self->stackView->spacing;
+	const int y = point->y - frame.y - stackView->padding.top;
+
+	if (stride <= 0 || y < 0) {
+		return -1;
+	}
+
+	const size_t i = y / stride;
+	if (i < self->visibleOptions.length) {
+		return self->visibleOptions.location + i;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Highlights the Option at the given index, scrolling it into view.
+ */
+static void highlightOption(Select *self, ssize_t index) {
+
+	const size_t count = ((Array *) self->options)->count;
+	if (count == 0) {
+		return;
+	}
+
+	index = clamp(index, 0, (ssize_t) count - 1);
+
+	if ((size_t) index < self->scrollIndex) {
+		self->scrollIndex = index;
+	} else if ((size_t) index >= self->scrollIndex + self->maxVisibleOptions) {
+		self->scrollIndex = index - self->maxVisibleOptions + 1;
+	}
+
+	self->highlightedOption = index;
+
+	self->control.view.needsLayout = true;
+}
+
+/**
+ * @brief Selects the Option at the given index, and notifies the delegate.
+ */
+static void selectOptionAtIndex(Select *self, size_t index) {
+
+	Option *option = $((Array *) self->options, objectAtIndex, index);
+
+	self->selectedOption = option;
+	if (self->delegate.didSelectOption) {
+		self->delegate.didSelectOption(self, option);
+	}
+
+	self->control.view.needsLayout = true;
+}
+
+/**
+ * @brief Comparator for sorting SelectTitles.
+ */
+static int compareTitles(const void *a, const void *b) {
+
+	const SelectTitle *t1 = a, *t2 = b;
+
+	const int order = strcasecmp(t1->title, t2->title);
+	if (order) {
+		return order;
+	}
+
+	return t1->index < t2->index ? -1 : t1->index > t2->index;
+}
+
+/**
+ * @brief Appends the given character to the type-ahead, and highlights the first Option whose
+ * title begins with it.
+ * @remarks The titles are sorted once, and then searched by bisection.
+ */
+static void typeAhead(Select *self, char c) {
+
+	const Array *options = (Array *) self->options;
+
+	if (self->titles == NULL) {
+
+		self->titles = calloc(options->count + 1, sizeof(SelectTitle));
+		assert(self->titles);
+
+		for (size_t i = 0; i < options->count; i++) {
+			const Option *option = $(options, objectAtIndex, i);
+
+			self->titles[i].title = option->title->text ?: "";
+			self->titles[i].index = i;
+		}
+
+		qsort(self->titles, options->count, sizeof(SelectTitle), compareTitles);
+	}
+
+	const Uint32 now = SDL_GetTicks();
+
+	size_t length = strlen(self->typeAhead);
+	if (now - self->typeAheadTime > SELECT_TYPE_AHEAD_TIMEOUT) {
+		length = 0;
+	}
+
+	if (length < SELECT_TYPE_AHEAD_SIZE - 1) {
+		self->typeAhead[length++] = c;
+		self->typeAhead[length] = '\0';
+	}
+
+	self->typeAheadTime = now;
+
+	size_t low = 0, high = options->count;
+	while (low < high) {
+		const size_t mid = (low + high) / 2;
+		if (strcasecmp(self->titles[mid].title, self->typeAhead) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low < options->count) {
+		if (strncasecmp(self->titles[low].title, self->typeAhead, length) == 0) {
+			highlightOption(self, self->titles[low].index);
+		}
+	}
+}
+
 #pragma mark - Object
 
 /**
@@ -43,6 +435,13 @@ static void dealloc(Object *self) {
 
 	release(this->stackView);
 
+	free(this->titles);
+
+	unindexAllOptions(this);
+
+	free(this->index->buckets);
+	free(this->index);
+
 	super(Object, self, dealloc);
 }
 
@@ -63,26 +462,41 @@ static void layoutSubviews(View *self) {
 	Select *this = (Select *) self;
 
 	const Array *options = (Array *) this->options;
-	for (size_t i = 0; i < options->count; i++) {
 
-		View *option = $(options, objectAtIndex, i);
-		if ((Option *) option == this->selectedOption) {
-			option->hidden = false;
-		} else {
-			option->hidden = this->control.state != ControlStateHighlighted;
+	Range range = { .location = 0, .length = 0 };
+
+	if (this->control.state == ControlStateHighlighted) {
+		range.length = min(this->maxVisibleOptions, options->count);
+
+		this->scrollIndex = min(this->scrollIndex, options->count - range.length);
+		range.location = this->scrollIndex;
+	} else {
+		const ssize_t index = selectedIndex(this);
+		if (index > -1) {
+			range.location = index;
+			range.length = 1;
 		}
+	}
+
+	displayOptions(this, range);
+
+	measureOptions(this);
+
+	for (size_t i = 0; i < range.length; i++) {
 
-		if (option->hidden == false) {
+		const ssize_t index = range.location + i;
 
-			if (this->control.state == ControlStateHighlighted) {
-				if ((Option *) option == this->selectedOption) {
-					option->backgroundColor = Colors.SelectedColor;
-				} else {
-					option->backgroundColor = Colors.HighlightedColor;
-				}
+		View *option = $(options, objectAtIndex, index);
+		option->frame.h = this->optionHeight;
+
+		if (this->control.state == ControlStateHighlighted) {
+			if (index == this->highlightedOption) {
+				option->backgroundColor = Colors.SelectedColor;
 			} else {
-				option->backgroundColor = Colors.Clear;
+				option->backgroundColor = Colors.HighlightedColor;
 			}
+		} else {
+			option->backgroundColor = Colors.Clear;
 		}
 	}
 
@@ -102,7 +516,7 @@ static void layoutSubviews(View *self) {
  */
 static SDL_Size sizeThatFits(const View *self) {
 
-	const Select *this = (Select *) self;
+	Select *this = (Select *) self;
 
 	SDL_Size size = super(View, self, sizeThatFits);
 
@@ -112,14 +526,9 @@ static SDL_Size sizeThatFits(const View *self) {
 		size.w = 0;
 	}
 
-	const Array *options = (Array *) this->options;
-	for (size_t i = 0; i < options->count; i++) {
+	measureOptions(this);
 
-		const View *option = (View *) $(options, objectAtIndex, i);
-		const SDL_Size optionSize = $(option, sizeThatFits);
-
-		size.w = max(size.w, optionSize.w + self->padding.left + self->padding.right);
-	}
+	size.w = max(size.w, this->optionWidth + self->padding.left + self->padding.right);
 
 	return size;
 }
@@ -137,17 +546,12 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
 		if (self->state == ControlStateHighlighted) {
 			self->state &= ~ControlStateHighlighted;
 
-			const Array *options = (Array *) this->options;
-			for (size_t i = 0; i < options->count; i++) {
+			const SDL_Point point = MakePoint(event->button.x, event->button.y);
 
-				Option *option = $(options, objectAtIndex, i);
-				if ($((View *) option, didReceiveEvent, event)) {
-					this->selectedOption = option;
-					if (this->delegate.didSelectOption) {
-						this->delegate.didSelectOption(this, option);
-					}
-					return true;
-				}
+			const ssize_t index = optionIndexAtPoint(this, &point);
+			if (index > -1) {
+				selectOptionAtIndex(this, index);
+				return true;
 			}
 		} else if ($((View *) self, didReceiveEvent, event)) {
 			self->state |= ControlStateHighlighted;
@@ -156,18 +560,61 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
 	}
 
 	else if (event->type == SDL_MOUSEMOTION) {
-		if (this->control.state == ControlStateHighlighted) {
+		if (self->state == ControlStateHighlighted) {
+
+			const SDL_Point point = MakePoint(event->motion.x, event->motion.y);
+
+			const ssize_t index = optionIndexAtPoint(this, &point);
+			if (index > -1 && index != this->highlightedOption) {
+				this->highlightedOption = index;
+				self->view.needsLayout = true;
+			}
+		}
+	}
+
+	else if (event->type == SDL_MOUSEWHEEL) {
+		if (self->state == ControlStateHighlighted) {
+			if ($((View *) this->stackView, didReceiveEvent, event)) {
+
+				const ssize_t scrollIndex = (ssize_t) this->scrollIndex - event->wheel.y;
+				this->scrollIndex = max(scrollIndex, 0);
 
-			const Array *options = (Array *) this->options;
-			for (size_t i = 0; i < options->count; i++) {
+				self->view.needsLayout = true;
+				return true;
+			}
+		}
+	}
+
+	else if (event->type == SDL_KEYDOWN) {
+		if (self->state == ControlStateHighlighted) {
 
-				View *option = $(options, objectAtIndex, i);
-				if ($(option, didReceiveEvent, event)) {
-					option->backgroundColor = Colors.SelectedColor;
-				} else {
-					option->backgroundColor = Colors.HighlightedColor;
-				}
+			const SDL_Keycode key = event->key.keysym.sym;
+
+			switch (key) {
+				case SDLK_UP:
+					highlightOption(this, this->highlightedOption - 1);
+					break;
+				case SDLK_DOWN:
+					highlightOption(this, this->highlightedOption + 1);
+					break;
+				case SDLK_KP_ENTER:
+				case SDLK_RETURN:
+					self->state &= ~ControlStateHighlighted;
+					if (this->highlightedOption > -1) {
+						selectOptionAtIndex(this, this->highlightedOption);
+					}
+					break;
+				case SDLK_ESCAPE:
+					self->state &= ~ControlStateHighlighted;
+					break;
+				default:
+					if (key >= SDLK_SPACE && key < SDLK_DELETE) {
+						typeAhead(this, (char) key);
+					}
+					break;
 			}
+
+			return true;
 		}
 	}
 
@@ -180,10 +627,17 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
  */
 static void stateDidChange(Control *self) {
 
+	Select *this = (Select *) self;
+
 	((View *) self)->needsLayout = true;
 
 	if (self->state & ControlStateHighlighted) {
 		self->view.zIndex = 4;
+
+		this->highlightedOption = selectedIndex(this);
+		this->scrollIndex = max(this->highlightedOption - (ssize_t) this->maxVisibleOptions / 2, 0);
+
+		this->typeAhead[0] = '\0';
 	} else {
 		self->view.zIndex = 0;
 	}
@@ -193,20 +647,6 @@ static void stateDidChange(Control *self) {
 
 #pragma mark - Select
 
-/**
- * @brief ArrayEnumerator to remove Options from the Select's StackView.
- */
-static void addOption_removeOptions(const Array *array, ident obj, ident data) {
-	$((View *) data, removeSubview, (View *) obj);
-}
-
-/**
- * @brief ArrayEnumerator to add Options to the Select's StacKView.
- */
-static void addOption_addOptions(const Array *array, ident obj, ident data) {
-	$((View *) data, addSubview, (View *) obj);
-}
-
 /**
  * @fn void Select::addOption(Select *self, const char *title, ident value)
  * @memberof Select
@@ -216,25 +656,82 @@ static void addOption(Select *self, const char *title, ident value) {
 	Option *option = $(alloc(Option), initWithTitle, title, value);
 	assert(option);
 
-	$(self->options, addObject, option);
-	$((View *) self->stackView, addSubview, (View *) option);
+	const Array *options = (Array *) self->options;
 
-	if (self->comparator) {
-		const Array *options = (Array *) self->options;
-		$(options, enumerateObjects, addOption_removeOptions, self->stackView);
-		$(self->options, sort, self->comparator);
-		$(options, enumerateObjects, addOption_addOptions, self->stackView);
+	if (self->comparator && options->count) {
+
+		size_t low = 0, high = options->count;
+		while (low < high) {
+			const size_t mid = (low + high) / 2;
+			if (self->comparator($(options, objectAtIndex, mid), option) == OrderDescending) {
+				high = mid;
+			} else {
+				low = mid + 1;
+			}
+		}
+
+		if (low < options->count) {
+			$(self->options, insertObjectAtIndex, option, low);
+		} else {
+			$(self->options, addObject, option);
+		}
+	} else {
+		$(self->options, addObject, option);
 	}
 
+	indexOption(self, option);
+
 	if (self->selectedOption == NULL) {
 		self->selectedOption = option;
 	}
 
-	self->control.view.needsLayout = true;
+	optionsDidChange(self);
 
 	release(option);
 }
 
+/**
+ * @fn void Select::addOptions(Select *self, const char **titles, const ident *values, size_t count)
+ * @memberof Select
+ */
+static void addOptions(Select *self, const char **titles, const ident *values, size_t count) {
+
+	if (count == 0) {
+		return;
+	}
+
+	assert(titles);
+	assert(values);
+
+	Option *first = NULL;
+
+	for (size_t i = 0; i < count; i++) {
+
+		Option *option = $(alloc(Option), initWithTitle, titles[i], values[i]);
+		assert(option);
+
+		$(self->options, addObject, option);
+
+		indexOption(self, option);
+
+		if (first == NULL) {
+			first = option;
+		}
+
+		release(option);
+	}
+
+	if (self->comparator) {
+		$(self->options, sort, self->comparator);
+	}
+
+	if (self->selectedOption == NULL) {
+		self->selectedOption = first;
+	}
+
+	optionsDidChange(self);
+}
+
 /**
  * @fn Select *Select::initWithFrame(Select *self, const SDL_Rect *frame, ControlStyle style)
  * @memberof Select
@@ -247,6 +744,9 @@ static Select *initWithFrame(Select *self, const SDL_Rect *frame, ControlStyle s
 		self->options = $$(MutableArray, array);
 		assert(self->options);
 
+		self->index = calloc(1, sizeof(SelectIndex));
+		assert(self->index);
+
 		self->stackView = $(alloc(StackView), initWithFrame, NULL);
 		assert(self->stackView);
 
@@ -258,6 +758,12 @@ static Select *initWithFrame(Select *self, const SDL_Rect *frame, ControlStyle s
 
 		self->control.selection = ControlSelectionSingle;
 
+		self->highlightedOption = -1;
+		self->maxVisibleOptions = DEFAULT_SELECT_MAX_VISIBLE_OPTIONS;
+		self->optionHeight = -1;
+		self->optionWidth = -1;
+		self->visibleOptions.location = -1;
+
 		if (self->control.style == ControlStyleDefault) {
 			self->control.bevel = ControlBevelTypeOutset;
 
@@ -272,26 +778,21 @@ static Select *initWithFrame(Select *self, const SDL_Rect *frame, ControlStyle s
 	return self;
 }
 
-/**
- * @brief Predicate function for optionWithValue.
- */
-static _Bool optionWithValue_predicate(ident obj, ident data) {
-	return ((Option *) obj)->value == data;
-}
-
 /**
  * @fn Option *Select::optionWithValue(const Select *self, ident value)
  * @memberof Select
  */
 static Option *optionWithValue(const Select *self, const ident value) {
-	return $((Array *) self->options, findObject, optionWithValue_predicate, value);
-}
 
-/**
- * @brief ArrayEnumerator for removeAllOptions.
- */
-static void removeAllOptions_enumerate(const Array *array, ident obj, ident data) {
-	$((View *) obj, removeFromSuperview);
+	if (self->index->count) {
+		for (const SelectIndexEntry *entry = *bucketForValue(self->index, value); entry; entry = entry->next) {
+			if (entry->option->value == value) {
+				return entry->option;
+			}
+		}
+	}
+
+	return NULL;
 }
 
 /**
@@ -301,13 +802,16 @@ static void removeAllOptions_enumerate(const Array *array, ident obj, ident data
  */
 static void removeAllOptions(Select *self) {
 
-	$((Array *) self->options, enumerateObjects, removeAllOptions_enumerate, self);
+	displayOptions(self, (Range) { .location = 0, .length = 0 });
 
 	$(self->options, removeAllObjects);
 
+	unindexAllOptions(self);
+
 	self->selectedOption = NULL;
+	self->highlightedOption = -1;
 
-	self->control.view.needsLayout = true;
+	optionsDidChange(self);
 }
 
 /**
@@ -316,15 +820,19 @@ static void removeAllOptions(Select *self) {
  */
 static void removeOption(Select *self, Option *option) {
 
+	unindexOption(self, option);
+
+	$((View *) option, removeFromSuperview);
+
 	$(self->options, removeObject, option);
 
 	if ((Option *) option == self->selectedOption) {
 		self->selectedOption = $((Array *) self->options, firstObject);
 	}
 
-	$((View *) option, removeFromSuperview);
+	self->highlightedOption = -1;
 
-	self->control.view.needsLayout = true;
+	optionsDidChange(self);
 }
 
 /**
@@ -344,7 +852,10 @@ static void removeOptionWithValue(Select *self, ident value) {
  * @memberof Select
  */
 static void selectOptionWithValue(Select *self, ident value) {
+
 	self->selectedOption = $(self, optionWithValue, value);
+
+	self->control.view.needsLayout = true;
 }
 
 #pragma mark - Class lifecycle
@@ -364,6 +875,7 @@ static void initialize(Class *clazz) {
 	((ControlInterface *) clazz->def->interface)->stateDidChange = stateDidChange;
 
 	((SelectInterface *) clazz->def->interface)->addOption = addOption;
+	((SelectInterface *) clazz->def->interface)->addOptions = addOptions;
 	((SelectInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
 	((SelectInterface *) clazz->def->interface)->optionWithValue = optionWithValue;
 	((SelectInterface *) clazz->def->interface)->removeAllOptions = removeAllOptions;
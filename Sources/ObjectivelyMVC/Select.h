@@ -33,8 +33,14 @@
  */
 
 #define DEFAULT_SELECT_WIDTH 100
+#define DEFAULT_SELECT_MAX_VISIBLE_OPTIONS 12
+
+#define SELECT_TYPE_AHEAD_SIZE 32
+#define SELECT_TYPE_AHEAD_TIMEOUT 1000
 
 typedef struct SelectDelegate SelectDelegate;
+typedef struct SelectIndex SelectIndex;
+typedef struct SelectTitle SelectTitle;
 
 typedef struct Select Select;
 typedef struct SelectInterface SelectInterface;
@@ -85,12 +91,50 @@ struct Select {
 	 */
 	SelectDelegate delegate;
 
+	/**
+	 * @brief The index of the Option highlighted while this Select is open, or `-1`.
+	 * @private
+	 */
+	ssize_t highlightedOption;
+
+	/**
+	 * @brief The Options, hashed by value.
+	 * @private
+	 */
+	SelectIndex *index;
+
+	/**
+	 * @brief The maximum count of Options displayed while this Select is open.
+	 * @remarks Only the displayed Options are added to the StackView, so large Selects remain
+	 * inexpensive to lay out and render. The mouse wheel scrolls through the remaining Options.
+	 */
+	size_t maxVisibleOptions;
+
+	/**
+	 * @brief The height of the tallest Option, at which all Options are presented, or `-1` if it
+	 * must be measured.
+	 * @private
+	 */
+	int optionHeight;
+
+	/**
+	 * @brief The width of the widest Option, or `-1` if it must be measured.
+	 * @private
+	 */
+	int optionWidth;
+
 	/**
 	 * @brief The Select Options.
 	 * @private
 	 */
 	MutableArray *options;
 
+	/**
+	 * @brief The index of the first Option displayed while this Select is open.
+	 * @private
+	 */
+	size_t scrollIndex;
+
 	/**
 	 * @brief The selected Option, or `NULL`.
 	 */
@@ -101,6 +145,30 @@ struct Select {
 	 * @private
 	 */
 	StackView *stackView;
+
+	/**
+	 * @brief The Option titles, sorted for type-ahead, or `NULL` if they must be sorted.
+	 * @private
+	 */
+	SelectTitle *titles;
+
+	/**
+	 * @brief The characters typed while this Select is open.
+	 * @private
+	 */
+	char typeAhead[SELECT_TYPE_AHEAD_SIZE];
+
+	/**
+	 * @brief The time of the last type-ahead key press, in milliseconds.
+	 * @private
+	 */
+	Uint32 typeAheadTime;
+
+	/**
+	 * @brief The range of Options in the StackView.
+	 * @private
+	 */
+	Range visibleOptions;
 };
 
 /**
@@ -123,6 +191,19 @@ struct SelectInterface {
 	 */
 	void (*addOption)(Select *self, const char *title, ident value);
 
+	/**
+	 * @fn void Select::addOptions(Select *self, const char **titles, const ident *values, size_t count)
+	 * @brief Creates and adds new Options to this Select.
+	 * @param self The Select.
+	 * @param titles The Option titles.
+	 * @param values The Option values.
+	 * @param count The count of `titles` and `values`.
+	 * @remarks If this Select has a comparator, the Options are sorted once, rather than as each
+	 * Option is added. Prefer this method to populate large Selects.
+	 * @memberof Select
+	 */
+	void (*addOptions)(Select *self, const char **titles, const ident *values, size_t count);
+
 	/**
 	 * @fn Select *Select::initWithFrame(Select *self, const SDL_Rect *frame, ControlStyle style)
 	 * @brief Initializes this Select with the specified frame and style.
@@ -138,7 +219,8 @@ struct SelectInterface {
 	 * @fn Option *Select::optionWithValue(const Select *self, ident value)
 	 * @param self The Select.
 	 * @param value The Option value.
-	 * @return The first Option with the given value.
+	 * @return The first Option added with the given value, or `NULL`.
+	 * @remarks Options are hashed by value, so this method runs in constant time.
 	 * @memberof Select
 	 */
 	Option *(*optionWithValue)(const Select *self, ident value);
@@ -162,7 +244,7 @@ struct SelectInterface {
 
 	/**
 	 * @fn void Select::removeOptionWithValue(Select *self, ident value)
-	 * @brief Removes first the Option with the given value.
+	 * @brief Removes the first Option added with the given value.
 	 * @param self The Select.
 	 * @param value The Option value.
 	 * @memberof Select
@@ -171,7 +253,7 @@ struct SelectInterface {
 
 	/**
 	 * @fn void Select::selectOptionWithValue(Select *self, ident value)
-	 * @brief Selects the first Option with the given value.
+	 * @brief Selects the first Option added with the given value.
 	 * @param self The Select.
 	 * @param value The Option value.
 	 * @memberof Select
@@ -22,6 +22,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <ObjectivelyMVC/StackView.h>
 
@@ -38,6 +39,32 @@ const EnumName StackViewDistributionNames[] = MakeEnumNames(
 
 #define _Class _StackView
 
+/**
+ * @return True if the given subview participates in stacking, false otherwise.
+ */
+static _Bool isStacked(const View *subview) {
+	return subview->hidden == false && subview->alignment != ViewAlignmentInternal;
+}
+
+/**
+ * @return The number of subviews of the given View that participate in stacking.
+ * @remarks Subviews are iterated in place, rather than via View::visibleSubviews, to avoid
+ * allocating an Array on every layout pass.
+ */
+static size_t countStackedSubviews(const View *self) {
+
+	size_t count = 0;
+
+	const Array *subviews = (Array *) self->subviews;
+	for (size_t i = 0; subviews && i < subviews->count; i++) {
+		if (isStacked($(subviews, objectAtIndex, i))) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
 #pragma mark - View
 
 /**
@@ -65,6 +92,19 @@ static View *init(View *self) {
 	return (View *) $((StackView *) self, initWithFrame, NULL);
 }
 
+/**
+ * @see View::layoutState(const View *, int *, size_t)
+ */
+static size_t layoutState(const View *self, int *states, size_t count) {
+
+	const StackView *this = (StackView *) self;
+
+	const int state[] = { this->axis, this->distribution, this->spacing };
+
+	memcpy(states, state, min(count, lengthof(state)) * sizeof(int));
+	return lengthof(state);
+}
+
 /**
  * @see View::layoutSubviews(View *)
  */
@@ -72,8 +112,10 @@ static void layoutSubviews(View *self) {
 
 	super(View, self, layoutSubviews);
 
-	Array *subviews = $(self, visibleSubviews);
-	if (subviews->count) {
+	const Array *subviews = (Array *) self->subviews;
+
+	const size_t count = countStackedSubviews(self);
+	if (count) {
 
 		StackView *this = (StackView *) self;
 
@@ -89,11 +131,15 @@ static void layoutSubviews(View *self) {
 				break;
 		}
 
-		availableSize -= this->spacing * (subviews->count - 1);
+		availableSize -= this->spacing * (count - 1);
 
 		for (size_t i = 0; i < subviews->count; i++) {
 
 			const View *subview = $(subviews, objectAtIndex, i);
+			if (isStacked(subview) == false) {
+				continue;
+			}
+
 			const SDL_Size size = $(subview, size);
 
 			switch (this->axis) {
@@ -113,6 +159,9 @@ static void layoutSubviews(View *self) {
 		for (size_t i = 0; i < subviews->count; i++) {
 
 			View *subview = $(subviews, objectAtIndex, i);
+			if (isStacked(subview) == false) {
+				continue;
+			}
 
 			switch (this->axis) {
 				case StackViewAxisVertical:
@@ -143,10 +192,10 @@ static void layoutSubviews(View *self) {
 				case StackViewDistributionFillEqually:
 					switch (this->axis) {
 						case StackViewAxisVertical:
-							subviewSize.h = availableSize / (float) subviews->count;
+							subviewSize.h = availableSize / (float) count;
 							break;
 						case StackViewAxisHorizontal:
-							subviewSize.w = availableSize / (float) subviews->count;
+							subviewSize.w = availableSize / (float) count;
 							break;
 					}
 					break;
@@ -166,8 +215,6 @@ static void layoutSubviews(View *self) {
 			pos += this->spacing;
 		}
 	}
-
-	release(subviews);
 }
 
 /**
@@ -190,10 +237,16 @@ static SDL_Size sizeThatFits(const View *self) {
 				break;
 		}
 
-		Array *subviews = $(self, visibleSubviews);
-		for (size_t i = 0; i < subviews->count; i++) {
+		const Array *subviews = (Array *) self->subviews;
+
+		const size_t count = countStackedSubviews(self);
+		for (size_t i = 0; count && i < subviews->count; i++) {
 
 			const View *subview = $(subviews, objectAtIndex, i);
+			if (isStacked(subview) == false) {
+				continue;
+			}
+
 			const SDL_Size subviewSize = $(subview, sizeThatContains);
 
 			switch (this->axis) {
@@ -206,18 +259,16 @@ static SDL_Size sizeThatFits(const View *self) {
 			}
 		}
 
-		if (subviews->count) {
+		if (count) {
 			switch (this->axis) {
 				case StackViewAxisVertical:
-					size.h += this->spacing * (subviews->count - 1);
+					size.h += this->spacing * (count - 1);
 					break;
 				case StackViewAxisHorizontal:
-					size.w += this->spacing * (subviews->count - 1);
+					size.w += this->spacing * (count - 1);
 					break;
 			}
 		}
-
-		release(subviews);
 	}
 
 	return size;
@@ -249,6 +300,7 @@ static void initialize(Class *clazz) {
 	((ViewInterface *) clazz->def->interface)->awakeWithDictionary = awakeWithDictionary;
 	((ViewInterface *) clazz->def->interface)->init = init;
 
+	((ViewInterface *) clazz->def->interface)->layoutState = layoutState;
 	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
 	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
 
@@ -37,6 +37,15 @@
 typedef struct TableColumn TableColumn;
 typedef struct TableColumnInterface TableColumnInterface;
 
+/**
+ * @brief A function type for formatting the values of flyweight TableColumns.
+ * @param column The TableColumn.
+ * @param value The value, as provided by the TableViewDataSource.
+ * @param buffer The buffer to which the null-terminated text should be written.
+ * @param size The size of `buffer`.
+ */
+typedef void (*TableColumnFormatter)(const TableColumn *column, const ident value, char *buffer, size_t size);
+
 /**
  * @brief Columns for TableViews.
  * @extends Object
@@ -65,6 +74,14 @@ struct TableColumn {
 	 */
 	Comparator comparator;
 
+	/**
+	 * @brief The formatter, or `NULL`.
+	 * @remarks Cells of columns with a formatter are flyweights: rather than requesting a
+	 * TableCellView from the delegate, the TableView formats the data source value of each visible
+	 * cell and draws it directly, so that no Views are allocated for these cells.
+	 */
+	TableColumnFormatter formatter;
+
 	/**
 	 * @brief The header cell.
 	 */
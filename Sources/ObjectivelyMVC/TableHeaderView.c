@@ -24,11 +24,30 @@
 #include <assert.h>
 
 #include <ObjectivelyMVC/TableHeaderView.h>
+#include <ObjectivelyMVC/TableView.h>
 
 #define _Class _TableHeaderView
 
 #pragma mark - View
 
+/**
+ * @see View::layoutSubviews(View *)
+ */
+static void layoutSubviews(View *self) {
+
+	super(View, self, layoutSubviews);
+
+	const TableRowView *this = (TableRowView *) self;
+	const int offset = this->tableView->scrollView->contentOffset.x;
+
+	const Array *cells = (Array *) this->cells;
+	for (size_t i = 0; cells && i < cells->count; i++) {
+
+		View *cell = $(cells, objectAtIndex, i);
+		cell->frame.x += offset;
+	}
+}
+
 /**
  * @see View::render(View *, Renderer *)
  */
@@ -77,6 +96,7 @@ static TableHeaderView *initWithTableView(TableHeaderView *self, TableView *tabl
 	if (self) {
 
 		((View *) self)->backgroundColor = Colors.DimGray;
+		((View *) self)->clipsSubviews = true;
 
 		if (((View *) self)->frame.h == 0) {
 			((View *) self)->frame.h = DEFAULT_TABLE_HEADER_VIEW_HEIGHT;
@@ -93,6 +113,7 @@ static TableHeaderView *initWithTableView(TableHeaderView *self, TableView *tabl
  */
 static void initialize(Class *clazz) {
 
+	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
 	((ViewInterface *) clazz->def->interface)->render = render;
 	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
 
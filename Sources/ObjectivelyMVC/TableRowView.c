@@ -22,12 +22,44 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <ObjectivelyMVC/TableRowView.h>
 #include <ObjectivelyMVC/TableView.h>
 
 #define _Class _TableRowView
 
+/**
+ * @brief The formatted value of a flyweight column, and its clipped presentation.
+ */
+struct TableRowViewFormattedCell {
+
+	/**
+	 * @brief The TableColumn, or `NULL` if the column is not a flyweight column.
+	 */
+	const TableColumn *column;
+
+	/**
+	 * @brief The formatted value.
+	 */
+	char string[TABLE_ROW_VIEW_FORMATTER_BUFFER_SIZE];
+
+	/**
+	 * @brief The formatted value, truncated to fit `width`.
+	 */
+	char clippedString[TABLE_ROW_VIEW_FORMATTER_BUFFER_SIZE];
+
+	/**
+	 * @brief The size of `clippedString`.
+	 */
+	SDL_Size clippedSize;
+
+	/**
+	 * @brief The width `clippedString` was truncated to fit, or `-1`.
+	 */
+	int width;
+};
+
 #pragma mark - Object
 
 /**
@@ -37,7 +69,11 @@ static void dealloc(Object *self) {
 
 	TableRowView *this = (TableRowView *) self;
 
-	release(this->cells);
+	if (this->cells) {
+		release(this->cells);
+	}
+
+	free(this->formattedCells);
 
 	super(Object, self, dealloc);
 }
@@ -46,27 +82,41 @@ static void dealloc(Object *self) {
 
 /**
  * @see View::layoutSubviews(View *)
+ * @remarks Cells are positioned from the column geometry shared by all rows of the table, rather
+ * than stacked, so that only the cells of visible columns need be instantiated.
  */
 static void layoutSubviews(View *self) {
 
 	TableRowView *this = (TableRowView *) self;
 
-	this->stackView.spacing = this->tableView->cellSpacing;
-
 	const Array *cells = (Array *) this->cells;
 	const Array *columns = (Array *) this->tableView->columns;
+	const int *offsets = this->tableView->columnOffsets;
 
-	assert(cells->count == columns->count);
+	if (offsets && cells) {
 
-	for (size_t i = 0; i < columns->count; i++) {
+		const SDL_Rect bounds = $(self, bounds);
 
-		TableCellView *cell = $(cells, objectAtIndex, i);
-		const TableColumn *column = $(columns, objectAtIndex, i);
+		for (size_t i = 0, j = 0; i < this->columnRange.length && j < cells->count; i++) {
 
-		cell->view.frame.w = column->width;
-	}
+			const size_t column = this->columnRange.location + i;
+
+			if (this->index > -1) {
+				const TableColumn *tableColumn = $(columns, objectAtIndex, column);
+				if (tableColumn->formatter) {
+					continue;
+				}
+			}
+
+			View *cell = $(cells, objectAtIndex, j++);
 
-	super(View, self, layoutSubviews);
+			cell->frame.x = offsets[column];
+			cell->frame.y = 0;
+
+			const SDL_Size size = MakeSize(offsets[column + 1] - offsets[column] - this->tableView->cellSpacing, bounds.h);
+			$(cell, resize, &size);
+		}
+	}
 }
 
 /**
@@ -78,19 +128,171 @@ static SDL_Size sizeThatFits(const View *self) {
 
 	SDL_Size size = MakeSize(0, this->tableView->rowHeight);
 
-	const Array *columns = (Array *) this->tableView->columns;
-	if (columns->count) {
-		for (size_t i = 0; i < columns->count; i++) {
-			const TableColumn *column = $(columns, objectAtIndex, i);
-			size.w += column->width;
-		}
+	if (this->index > -1) {
+		size.h = this->stackView.view.frame.h;
+	}
 
-		size.w += (columns->count - 1) * this->tableView->cellSpacing;
+	const int *offsets = this->tableView->columnOffsets;
+	if (offsets) {
+
+		const size_t count = ((Array *) this->tableView->columns)->count;
+		if (count) {
+			size.w = offsets[count] - this->tableView->cellSpacing;
+		}
 	}
 
 	return size;
 }
 
+/**
+ * @brief Formats the values of the flyweight columns of this row.
+ */
+static void render_format(TableRowView *self) {
+
+	const TableView *tableView = self->tableView;
+	const Array *columns = (Array *) tableView->columns;
+
+	const size_t count = self->columnRange.length;
+
+	self->formattedCells = realloc(self->formattedCells, (count + 1) * sizeof(TableRowViewFormattedCell));
+	assert(self->formattedCells);
+
+	for (size_t i = 0; i < count; i++) {
+
+		TableRowViewFormattedCell *cell = &self->formattedCells[i];
+
+		cell->column = $(columns, objectAtIndex, self->columnRange.location + i);
+		if (cell->column->formatter == NULL) {
+			cell->column = NULL;
+			continue;
+		}
+
+		ident value;
+		if (tableView->dataSource.valuesForColumnInRange) {
+			const Range range = { .location = self->index, .length = 1 };
+			tableView->dataSource.valuesForColumnInRange(tableView, cell->column, range, &value);
+		} else {
+			value = tableView->dataSource.valueForColumnAndRow(tableView, cell->column, self->index);
+		}
+
+		cell->string[0] = '\0';
+		cell->column->formatter(cell->column, value, cell->string, sizeof(cell->string));
+
+		cell->width = -1;
+	}
+
+	self->formattedCellsCount = count;
+}
+
+/**
+ * @brief Truncates the formatted value of the given cell to fit `width`.
+ */
+static void render_clip(TableRowViewFormattedCell *cell, Renderer *renderer, Font *font, int width) {
+
+	cell->clippedSize = MakeSize(0, 0);
+
+	size_t length = 0;
+	for (const char *c = cell->string; *c; c++) {
+
+		if ((*c & 0xc0) != 0x80) {
+
+			const SDL_Size size = $(renderer, sizeCharacters, font, (const char []) { *c, '\0' });
+			if (cell->clippedSize.w + size.w > width) {
+				break;
+			}
+
+			cell->clippedSize.w += size.w;
+			cell->clippedSize.h = max(cell->clippedSize.h, size.h);
+		}
+
+		length++;
+	}
+
+	memcpy(cell->clippedString, cell->string, length);
+	cell->clippedString[length] = '\0';
+
+	if (cell->clippedSize.h == 0) {
+		cell->clippedSize.h = $(renderer, sizeCharacters, font, " ").h;
+	}
+
+	cell->width = width;
+}
+
+/**
+ * @see View::render(View *, Renderer *)
+ * @remarks The cells of flyweight columns are formatted once from the data source, and drawn
+ * directly, truncated to fit their columns. The row's clipping frame is used for all of them.
+ */
+static void render(View *self, Renderer *renderer) {
+
+	super(View, self, render, renderer);
+
+	TableRowView *this = (TableRowView *) self;
+	const TableView *tableView = this->tableView;
+
+	const int *offsets = tableView->columnOffsets;
+	if (this->index < 0 || offsets == NULL) {
+		return;
+	}
+
+	if (tableView->dataSource.isRowReady && tableView->dataSource.isRowReady(tableView, this->index) == false) {
+		return;
+	}
+
+	if (this->formattedCellsCount == 0) {
+		render_format(this);
+	}
+
+	Font *font = $$(Font, defaultFont, FontCategoryDefault);
+
+	const SDL_Rect frame = $(self, renderFrame);
+	const int padding = DEFAULT_TABLE_CELL_VIEW_PADDING;
+
+	for (size_t i = 0; i < this->formattedCellsCount; i++) {
+
+		TableRowViewFormattedCell *cell = &this->formattedCells[i];
+		if (cell->column == NULL) {
+			continue;
+		}
+
+		const size_t index = this->columnRange.location + i;
+
+		const SDL_Rect cellFrame = MakeRect(
+			frame.x + offsets[index] + padding,
+			frame.y + padding,
+			offsets[index + 1] - offsets[index] - tableView->cellSpacing - padding * 2,
+			frame.h - padding * 2
+		);
+
+		if (cell->width != cellFrame.w) {
+			render_clip(cell, renderer, font, cellFrame.w);
+		}
+
+		const SDL_Size *size = &cell->clippedSize;
+
+		ViewAlignment alignment = cell->column->cellAlignment;
+		if (alignment == ViewAlignmentNone) {
+			alignment = ViewAlignmentMiddleLeft;
+		}
+
+		SDL_Point origin = MakePoint(cellFrame.x, cellFrame.y + (cellFrame.h - size->h) / 2);
+
+		if (alignment & ViewAlignmentMaskCenter) {
+			origin.x += (cellFrame.w - size->w) / 2;
+		} else if (alignment & ViewAlignmentMaskRight) {
+			origin.x += cellFrame.w - size->w;
+		}
+
+		if (alignment & ViewAlignmentMaskTop) {
+			origin.y = cellFrame.y;
+		} else if (alignment & ViewAlignmentMaskBottom) {
+			origin.y = cellFrame.y + cellFrame.h - size->h;
+		}
+
+		$(renderer, drawCharacters, font, cell->clippedString, &origin);
+	}
+}
+
 #pragma mark - TableRowView
 
 /**
@@ -101,6 +303,11 @@ static void addCell(TableRowView *self, TableCellView *cell) {
 
 	assert(cell);
 
+	if (self->cells == NULL) {
+		self->cells = $$(MutableArray, arrayWithCapacity, ((Array *) self->tableView->columns)->count);
+		assert(self->cells);
+	}
+
 	$(self->cells, addObject, cell);
 
 	$((View *) self, addSubview, (View *) cell);
@@ -115,8 +322,7 @@ static TableRowView *initWithTableView(TableRowView *self, TableView *tableView)
 	self = (TableRowView *) super(StackView, self, initWithFrame, NULL);
 	if (self) {
 
-		self->cells = $$(MutableArray, array);
-		assert(self->cells);
+		self->index = -1;
 
 		self->tableView = tableView;
 		assert(self->tableView);
@@ -130,13 +336,6 @@ static TableRowView *initWithTableView(TableRowView *self, TableView *tableView)
 	return self;
 }
 
-/**
- * @brief ArrayEnumerator to remove TableCellViews from the row.
- */
-static void removeAllCells_enumerate(const Array *array, ident obj, ident data) {
-	$((View *) obj, removeFromSuperview);
-}
-
 /**
  * @fn void TableRowView::removeAllCells(TableRowView *self)
  * @brief Removes all cells from this row.
@@ -144,7 +343,18 @@ static void removeAllCells_enumerate(const Array *array, ident obj, ident data)
  */
 static void removeAllCells(TableRowView *self) {
 
-	$((Array *) self->cells, enumerateObjects, removeAllCells_enumerate, NULL);
+	self->formattedCellsCount = 0;
+
+	const Array *cells = (Array *) self->cells;
+	if (cells == NULL) {
+		return;
+	}
+
+	for (ssize_t i = cells->count - 1; i >= 0; i--) {
+
+		View *cell = $(cells, objectAtIndex, i);
+		$(cell, removeFromSuperview);
+	}
 
 	$(self->cells, removeAllObjects);
 }
@@ -157,7 +367,9 @@ static void removeCell(TableRowView *self, TableCellView *cell) {
 
 	assert(cell);
 
-	$(self->cells, removeObject, cell);
+	if (self->cells) {
+		$(self->cells, removeObject, cell);
+	}
 
 	$((View *) self, removeSubview, (View *) cell);
 }
@@ -186,6 +398,7 @@ static void initialize(Class *clazz) {
 	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
 
 	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
+	((ViewInterface *) clazz->def->interface)->render = render;
 	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
 
 	((TableRowViewInterface *) clazz->def->interface)->addCell = addCell;
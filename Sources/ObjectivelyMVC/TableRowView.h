@@ -31,8 +31,12 @@
  * @brief Rows for TableViews.
  */
 
+#define TABLE_ROW_VIEW_FORMATTER_BUFFER_SIZE 256
+
 typedef struct TableView TableView;
 
+typedef struct TableRowViewFormattedCell TableRowViewFormattedCell;
+
 typedef struct TableRowView TableRowView;
 typedef struct TableRowViewInterface TableRowViewInterface;
 
@@ -61,9 +65,33 @@ struct TableRowView {
 
 	/**
 	 * @brief The cells.
+	 * @remarks This is `NULL` until the first cell is added.
 	 */
 	MutableArray *cells;
 
+	/**
+	 * @brief The range of column indexes presented by `cells`.
+	 */
+	Range columnRange;
+
+	/**
+	 * @brief The formatted values of the columns in `columnRange`, for flyweight columns.
+	 * @remarks These are formatted on first render, and discarded with the cells.
+	 * @private
+	 */
+	TableRowViewFormattedCell *formattedCells;
+
+	/**
+	 * @brief The count of `formattedCells`, or `0` if the row must be formatted.
+	 * @private
+	 */
+	size_t formattedCellsCount;
+
+	/**
+	 * @brief The data source index of the row this view presents, or `-1`.
+	 */
+	ssize_t index;
+
 	/**
 	 * @brief True when this row is selected, false otherwise.
 	 */
@@ -108,6 +136,7 @@ struct TableRowViewInterface {
 	 * @fn void TableRowView::removeAllCells(TableRowView *self)
 	 * @brief Removes all cells from this row.
 	 * @param self The TableRowView.
+	 * @remarks The formatted values of flyweight columns are discarded, too.
 	 * @memberof TableRowView
 	 */
 	void (*removeAllCells)(TableRowView *self);
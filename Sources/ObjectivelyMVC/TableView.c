@@ -21,13 +21,1695 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/String.h>
+
+#include <ObjectivelyMVC/TableView.h>
+
+#define _Class _TableView
+
+/**
+ * @return The data source index of the row presented at the given position.
+ */
+static size_t rowAtPosition(const TableView *self, size_t position) {
+	return self->rowMapping ? self->rowMapping[position] : position;
+}
+
+/**
+ * @return The number of presented rows.
+ */
+static size_t numberOfPresentedRows(const TableView *self) {
+	return self->rowMapping ? self->rowMappingCount : self->numberOfRows;
+}
+
+/**
+ * @return The position at which the row at the given data source index is presented, or `-1`.
+ */
+static ssize_t positionOfRow(const TableView *self, size_t index) {
+
+	if (index >= self->numberOfRows) {
+		return -1;
+	}
+
+	return self->rowMapping ? self->rowPositions[index] : (ssize_t) index;
+}
+
+/**
+ * @brief A run of consecutive data source indexes, presented at consecutive positions.
+ */
+struct TableViewRowRun {
+
+	/**
+	 * @brief The position of the first row of the run.
+	 */
+	size_t position;
+
+	/**
+	 * @brief The data source index of the first row of the run.
+	 */
+	size_t row;
+
+	/**
+	 * @brief The count of rows in the run.
+	 */
+	size_t length;
+};
+
+/**
+ * @brief Discards the runs of the row mapping after a change to it.
+ */
+static void invalidateRowRuns(TableView *self) {
+
+	free(self->rowRuns);
+	self->rowRuns = NULL;
+	self->rowRunsCount = 0;
+}
+
+/**
+ * @brief Coalesces the row mapping into runs of consecutive data source indexes, if needed.
+ */
+static void buildRowRuns(TableView *self) {
+
+	if (self->rowRuns || self->rowMappingCount == 0) {
+		return;
+	}
+
+	size_t count = 1;
+	for (size_t i = 1; i < self->rowMappingCount; i++) {
+		if (self->rowMapping[i] != self->rowMapping[i - 1] + 1) {
+			count++;
+		}
+	}
+
+	self->rowRuns = calloc(count, sizeof(TableViewRowRun));
+	assert(self->rowRuns);
+
+	TableViewRowRun *run = self->rowRuns;
+	*run = (TableViewRowRun) { .position = 0, .row = self->rowMapping[0], .length = 1 };
+
+	for (size_t i = 1; i < self->rowMappingCount; i++) {
+		if (self->rowMapping[i] == self->rowMapping[i - 1] + 1) {
+			run->length++;
+		} else {
+			*++run = (TableViewRowRun) { .position = i, .row = self->rowMapping[i], .length = 1 };
+		}
+	}
+
+	self->rowRunsCount = count;
+}
+
+/**
+ * @brief Rebuilds the presentation positions of the rows from the row mapping, in linear time.
+ */
+static void buildRowPositions(TableView *self) {
+
+	invalidateRowRuns(self);
+
+	free(self->rowPositions);
+	self->rowPositions = NULL;
+
+	if (self->rowMapping) {
+
+		self->rowPositions = calloc(self->numberOfRows + 1, sizeof(ssize_t));
+		assert(self->rowPositions);
+
+		for (size_t i = 0; i < self->numberOfRows; i++) {
+			self->rowPositions[i] = -1;
+		}
+
+		for (size_t i = 0; i < self->rowMappingCount; i++) {
+			self->rowPositions[self->rowMapping[i]] = i;
+		}
+	}
+}
+
+/**
+ * @brief Updates the presentation positions of the rows presented from the given position onward.
+ */
+static void updateRowPositions(TableView *self, size_t position) {
+
+	invalidateRowRuns(self);
+
+	for (size_t i = position; i < self->rowMappingCount; i++) {
+		self->rowPositions[self->rowMapping[i]] = i;
+	}
+}
+
+/**
+ * @brief Requests the heights of all rows from the delegate.
+ */
+static void reloadRowHeights(TableView *self) {
+
+	free(self->rowHeights);
+	self->rowHeights = NULL;
+
+	if (self->delegate.heightForRow) {
+
+		self->rowHeights = calloc(self->numberOfRows + 1, sizeof(int));
+		assert(self->rowHeights);
+
+		for (size_t i = 0; i < self->numberOfRows; i++) {
+			self->rowHeights[i] = self->delegate.heightForRow(self, i);
+		}
+	}
+}
+
+/**
+ * @brief Rebuilds the Fenwick tree of the presented row heights, in linear time.
+ */
+static void buildRowHeightTree(TableView *self) {
+
+	free(self->rowHeightTree);
+	self->rowHeightTree = NULL;
+	self->rowHeightTreeCount = 0;
+
+	if (self->rowHeights) {
+
+		const size_t count = numberOfPresentedRows(self);
+
+		self->rowHeightTree = calloc(count + 1, sizeof(int));
+		assert(self->rowHeightTree);
+
+		for (size_t i = 1; i <= count; i++) {
+			self->rowHeightTree[i] += self->rowHeights[rowAtPosition(self, i - 1)];
+
+			const size_t parent = i + (i & -i);
+			if (parent <= count) {
+				self->rowHeightTree[parent] += self->rowHeightTree[i];
+			}
+		}
+
+		self->rowHeightTreeCount = count;
+	}
+}
+
+/**
+ * @brief Adds `delta` to the height of the row presented at the given position.
+ */
+static void updateRowHeightTree(TableView *self, size_t position, int delta) {
+
+	for (size_t i = position + 1; i <= self->rowHeightTreeCount; i += i & -i) {
+		self->rowHeightTree[i] += delta;
+	}
+}
+
+/**
+ * @return The offset of the row presented at the given position.
+ */
+static int rowOffset(const TableView *self, size_t position) {
+
+	if (self->rowHeightTree) {
+
+		int offset = 0;
+		for (size_t i = min(position, self->rowHeightTreeCount); i; i -= i & -i) {
+			offset += self->rowHeightTree[i];
+		}
+
+		return offset;
+	}
+
+	return position * max(self->rowHeight, 1);
+}
+
+/**
+ * @return The height of the row presented at the given position.
+ */
+static int rowHeightAtPosition(const TableView *self, size_t position) {
+
+	if (self->rowHeightTree) {
+		return self->rowHeights[rowAtPosition(self, position)];
+	}
+
+	return max(self->rowHeight, 1);
+}
+
+/**
+ * @return The position of the row presented at the given offset, which may be beyond the last row.
+ */
+static size_t positionAtOffset(const TableView *self, int offset) {
+
+	if (offset < 0) {
+		return 0;
+	}
+
+	if (self->rowHeightTree) {
+
+		const size_t count = self->rowHeightTreeCount;
+
+		size_t step = 1;
+		while ((step << 1) <= count) {
+			step <<= 1;
+		}
+
+		size_t position = 0;
+		for (; step && count; step >>= 1) {
+			if (position + step <= count && self->rowHeightTree[position + step] <= offset) {
+				position += step;
+				offset -= self->rowHeightTree[position];
+			}
+		}
+
+		return position;
+	}
+
+	return offset / max(self->rowHeight, 1);
+}
+
+/**
+ * @brief Binary searches the given sorted indexes for `index`.
+ * @return The position of `index`, or the position at which it would be inserted.
+ */
+static size_t searchIndexes(const size_t *indexes, size_t count, size_t index) {
+
+	size_t low = 0, high = count;
+	while (low < high) {
+		const size_t mid = (low + high) >> 1;
+		if (indexes[mid] < index) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * @brief qsort comparator for row indexes.
+ */
+static int compareIndexes(const void *a, const void *b) {
+
+	const size_t index1 = *(size_t *) a;
+	const size_t index2 = *(size_t *) b;
+
+	return index1 < index2 ? OrderAscending : index1 > index2 ? OrderDescending : OrderSame;
+}
+
+/**
+ * @return The position of the first selected range that ends after the given index.
+ */
+static size_t searchSelection(const TableView *self, size_t index) {
+
+	size_t low = 0, high = self->selectionCount;
+	while (low < high) {
+		const size_t mid = (low + high) >> 1;
+		const Range *range = self->selection + mid;
+		if ((size_t) range->location + range->length <= index) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/**
+ * @return True if the row at the given index is selected, false otherwise.
+ */
+static _Bool isRowSelected(const TableView *self, size_t index) {
+
+	const size_t position = searchSelection(self, index);
+
+	return position < self->selectionCount && (size_t) self->selection[position].location <= index;
+}
+
+/**
+ * @brief Replaces the selected ranges at positions `[from, to)` with the given ranges.
+ */
+static void replaceSelection(TableView *self, size_t from, size_t to, const Range *ranges, size_t count) {
+
+	const size_t selectionCount = self->selectionCount - (to - from) + count;
+
+	if (count > to - from) {
+		self->selection = realloc(self->selection, selectionCount * sizeof(Range));
+		assert(self->selection);
+	}
+
+	memmove(self->selection + from + count, self->selection + to, (self->selectionCount - to) * sizeof(Range));
+	memcpy(self->selection + from, ranges, count * sizeof(Range));
+
+	self->selectionCount = selectionCount;
+}
+
+/**
+ * @brief Adds or removes the rows at indexes `[start, end)` to or from the selection.
+ */
+static void setRowsSelected(TableView *self, size_t start, size_t end, _Bool selected) {
+
+	if (start >= end) {
+		return;
+	}
+
+	if (selected) {
+
+		const size_t from = start ? searchSelection(self, start - 1) : 0;
+
+		size_t to = from;
+		while (to < self->selectionCount && (size_t) self->selection[to].location <= end) {
+			to++;
+		}
+
+		if (from < to) {
+			const Range *first = self->selection + from, *last = self->selection + to - 1;
+
+			start = min(start, (size_t) first->location);
+			end = max(end, (size_t) last->location + last->length);
+		}
+
+		const Range range = { .location = start, .length = end - start };
+		replaceSelection(self, from, to, &range, 1);
+
+	} else {
+
+		const size_t from = searchSelection(self, start);
+
+		size_t to = from;
+		while (to < self->selectionCount && (size_t) self->selection[to].location < end) {
+			to++;
+		}
+
+		Range ranges[2];
+		size_t count = 0;
+
+		if (from < to) {
+			const Range *first = self->selection + from, *last = self->selection + to - 1;
+
+			if ((size_t) first->location < start) {
+				ranges[count++] = (Range) { .location = first->location, .length = start - first->location };
+			}
+
+			const size_t lastEnd = last->location + last->length;
+			if (lastEnd > end) {
+				ranges[count++] = (Range) { .location = end, .length = lastEnd - end };
+			}
+		}
+
+		replaceSelection(self, from, to, ranges, count);
+	}
+}
+
+/**
+ * @brief qsort comparator for Ranges, by location.
+ */
+static int compareRanges(const void *a, const void *b) {
+
+	const Range *range1 = (Range *) a;
+	const Range *range2 = (Range *) b;
+
+	return range1->location < range2->location ? OrderAscending :
+		range1->location > range2->location ? OrderDescending : OrderSame;
+}
+
+/**
+ * @brief Adds the given ranges, sorted by location, to the selection, in a single merge.
+ */
+static void unionSelection(TableView *self, const Range *ranges, size_t count) {
+
+	Range *selection = calloc(self->selectionCount + count + 1, sizeof(Range));
+	assert(selection);
+
+	size_t i = 0, j = 0, k = 0;
+	while (i < self->selectionCount || j < count) {
+
+		Range range;
+		if (j == count || (i < self->selectionCount && self->selection[i].location <= ranges[j].location)) {
+			range = self->selection[i++];
+		} else {
+			range = ranges[j++];
+		}
+
+		Range *previous = k ? selection + k - 1 : NULL;
+		if (previous && previous->location + (ssize_t) previous->length >= range.location) {
+
+			const ssize_t end = max(previous->location + (ssize_t) previous->length, range.location + (ssize_t) range.length);
+			previous->length = end - previous->location;
+		} else {
+			selection[k++] = range;
+		}
+	}
+
+	free(self->selection);
+
+	self->selection = selection;
+	self->selectionCount = k;
+}
+
+/**
+ * @brief Adds the rows presented at positions `[start, end)` to the selection.
+ * @remarks With a row mapping, this costs time in the number of runs of the mapping in the given
+ * positions, rather than in the number of rows.
+ */
+static void selectPositions(TableView *self, size_t start, size_t end) {
+
+	if (self->rowMapping == NULL) {
+		setRowsSelected(self, start, min(end, self->numberOfRows), true);
+		return;
+	}
+
+	end = min(end, self->rowMappingCount);
+	if (start >= end) {
+		return;
+	}
+
+	buildRowRuns(self);
+
+	size_t low = 0, high = self->rowRunsCount;
+	while (low < high) {
+		const size_t mid = (low + high) >> 1;
+		const TableViewRowRun *run = self->rowRuns + mid;
+		if (run->position + run->length <= start) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	size_t last = low;
+	while (last < self->rowRunsCount && self->rowRuns[last].position < end) {
+		last++;
+	}
+
+	Range *ranges = calloc(last - low + 1, sizeof(Range));
+	assert(ranges);
+
+	size_t count = 0;
+	for (size_t i = low; i < last; i++) {
+
+		const TableViewRowRun *run = self->rowRuns + i;
+
+		const size_t from = max(start, run->position);
+		const size_t to = min(end, run->position + run->length);
+
+		ranges[count++] = (Range) { .location = run->row + (from - run->position), .length = to - from };
+	}
+
+	qsort(ranges, count, sizeof(Range), compareRanges);
+
+	unionSelection(self, ranges, count);
+
+	free(ranges);
+}
+
+/**
+ * @brief Selects the rows presented between the rows at the given indexes, inclusive.
+ */
+static void selectRowsBetween(TableView *self, size_t index1, size_t index2) {
+
+	const ssize_t position1 = positionOfRow(self, index1);
+	const ssize_t position2 = positionOfRow(self, index2);
+
+	if (position1 > -1 && position2 > -1) {
+		selectPositions(self, min(position1, position2), max(position1, position2) + 1);
+	}
+
+	self->control.view.needsLayout = true;
+}
+
+/**
+ * @brief Fetches the values of the given column for the rows in the given range.
+ */
+static void valuesForColumnInRange(const TableView *self, const TableColumn *column, const Range range, ident *values) {
+
+	if (self->dataSource.valuesForColumnInRange) {
+		self->dataSource.valuesForColumnInRange(self, column, range, values);
+	} else {
+		assert(self->dataSource.valueForColumnAndRow);
+
+		for (size_t i = 0; i < range.length; i++) {
+			values[i] = self->dataSource.valueForColumnAndRow(self, column, range.location + i);
+		}
+	}
+}
+
+/**
+ * @brief Compares the given values by the given Comparator and sort order.
+ */
+static Order compareValues(Comparator comparator, Order order, const ident value1, const ident value2) {
+
+	switch (order) {
+		case OrderAscending:
+			return comparator(value1, value2);
+		case OrderSame:
+			return OrderSame;
+		case OrderDescending:
+			return comparator(value2, value1);
+	}
+
+	return OrderSame;
+}
+
+/**
+ * @brief Inserts the row at the given index into the row mapping, by binary search of the sort
+ * column. Rows with equal values, or all rows if the table is not sorted, retain their data source
+ * order.
+ * @remarks The row mapping must have capacity for one more row.
+ */
+static void insertRowMapping(TableView *self, size_t index) {
+
+	const TableColumn *column = self->sortColumn;
+	const _Bool isSorted = column && column->comparator;
+
+	ident value = NULL;
+	if (isSorted) {
+		valuesForColumnInRange(self, column, (Range) { .location = index, .length = 1 }, &value);
+	}
+
+	size_t low = 0, high = self->rowMappingCount;
+	while (low < high) {
+		const size_t mid = (low + high) >> 1;
+		const size_t other = self->rowMapping[mid];
+
+		Order order = OrderSame;
+		if (isSorted) {
+			ident otherValue;
+			valuesForColumnInRange(self, column, (Range) { .location = other, .length = 1 }, &otherValue);
+
+			order = compareValues(column->comparator, column->order, otherValue, value);
+		}
+
+		if (order == OrderSame) {
+			order = other < index ? OrderAscending : OrderDescending;
+		}
+
+		if (order == OrderDescending) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	size_t *mapping = self->rowMapping + low;
+	memmove(mapping + 1, mapping, (self->rowMappingCount - low) * sizeof(size_t));
+
+	*mapping = index;
+	self->rowMappingCount++;
+
+	updateRowPositions(self, low);
+}
+
+/**
+ * @brief Removes the row at the given index from the row mapping.
+ * @return True if the row was presented, false otherwise.
+ */
+static _Bool removeRowMapping(TableView *self, size_t index) {
+
+	const ssize_t position = positionOfRow(self, index);
+	if (position == -1) {
+		return false;
+	}
+
+	size_t *mapping = self->rowMapping + position;
+	memmove(mapping, mapping + 1, (self->rowMappingCount - position - 1) * sizeof(size_t));
+
+	self->rowMappingCount--;
+
+	self->rowPositions[index] = -1;
+	updateRowPositions(self, position);
+
+	return true;
+}
+
+/**
+ * @brief A packed sort key, pairing a row's sort column value with its data source index.
+ */
+typedef struct {
+	ident value;
+	size_t row;
+} SortKey;
+
+static __thread Comparator _sortComparator;
+static __thread Order _sortOrder;
+
+/**
+ * @brief qsort comparator for SortKeys. Rows with equal values retain their data source order.
+ * @remarks This function relies on thread-local-storage.
+ */
+static int sortRows_compare(const void *a, const void *b) {
+
+	const SortKey *key1 = (SortKey *) a;
+	const SortKey *key2 = (SortKey *) b;
+
+	const Order order = compareValues(_sortComparator, _sortOrder, key1->value, key2->value);
+	if (order == OrderSame) {
+		return key1->row < key2->row ? OrderAscending : OrderDescending;
+	}
+
+	return order;
+}
+
+/**
+ * @brief Rebuilds the row mapping by sorting all rows by the sort column.
+ */
+static void sortRows(TableView *self) {
+
+	free(self->rowMapping);
+	self->rowMapping = NULL;
+	self->rowMappingCount = 0;
+
+	const size_t numberOfRows = self->numberOfRows;
+
+	if (self->sortColumn && self->sortColumn->comparator && numberOfRows) {
+
+		ident *values = calloc(numberOfRows, sizeof(ident));
+		assert(values);
+
+		SortKey *keys = calloc(numberOfRows, sizeof(SortKey));
+		assert(keys);
+
+		valuesForColumnInRange(self, self->sortColumn, (Range) { .location = 0, .length = numberOfRows }, values);
+
+		for (size_t i = 0; i < numberOfRows; i++) {
+			keys[i].value = values[i];
+			keys[i].row = i;
+		}
+
+		_sortComparator = self->sortColumn->comparator;
+		_sortOrder = self->sortColumn->order;
+
+		qsort(keys, numberOfRows, sizeof(SortKey), sortRows_compare);
+
+		self->rowMapping = calloc(numberOfRows, sizeof(size_t));
+		assert(self->rowMapping);
+
+		for (size_t i = 0; i < numberOfRows; i++) {
+			self->rowMapping[i] = keys[i].row;
+		}
+
+		self->rowMappingCount = numberOfRows;
+
+		free(values);
+		free(keys);
+	}
+
+	buildRowPositions(self);
+}
+
+/**
+ * @brief Creates an IndexSet of the data source indexes of the rows presented at positions in
+ * `range` but not in `exclude`.
+ * @return The IndexSet, or `NULL` if it would be empty.
+ */
+static IndexSet *prefetchRows_indexes(const TableView *self, const Range range, const Range exclude) {
+
+	size_t *indexes = calloc(range.length + 1, sizeof(size_t));
+	assert(indexes);
+
+	size_t count = 0;
+	for (size_t i = 0; i < range.length; i++) {
+
+		const ssize_t position = range.location + i;
+		if (position < exclude.location || position >= exclude.location + (ssize_t) exclude.length) {
+			indexes[count++] = rowAtPosition(self, position);
+		}
+	}
+
+	IndexSet *indexSet = NULL;
+	if (count) {
+		qsort(indexes, count, sizeof(size_t), compareIndexes);
+		indexSet = $(alloc(IndexSet), initWithIndexes, indexes, count);
+	}
+
+	free(indexes);
+	return indexSet;
+}
+
+/**
+ * @brief Cancels prefetching of the rows in the prefetch range, and resets it.
+ * @remarks This must be called before the row mapping changes, while the prefetch range still
+ * refers to the positions it was computed against.
+ */
+static void cancelPrefetching(TableView *self) {
+
+	const Range range = self->prefetchRange;
+
+	if (range.length && self->delegate.cancelPrefetchingForRowsAtIndexes) {
+		IndexSet *indexes = prefetchRows_indexes(self, range, (Range) { .location = 0, .length = 0 });
+		if (indexes) {
+			self->delegate.cancelPrefetchingForRowsAtIndexes(self, indexes);
+			release(indexes);
+		}
+	}
+
+	self->prefetchRange = (Range) { .location = 0, .length = 0 };
+}
+
+/**
+ * @brief A snapshot of the values of the columns for all rows, shared by filter jobs.
+ * @details Each column is gathered from the data source, with a single bulk call, the first time a
+ * job needs it. It is then reused by every later job, including refinements, until the rows or the
+ * columns change. Jobs retain the snapshot, so that it outlives changes made while they run.
+ */
+typedef struct {
+
+	/**
+	 * @brief The reference count.
+	 */
+	SDL_atomic_t referenceCount;
+
+	/**
+	 * @brief The number of columns and rows.
+	 */
+	size_t numberOfColumns, numberOfRows;
+
+	/**
+	 * @brief The values of each column, by column index, or `NULL` until they are gathered.
+	 */
+	ident **columns;
+} TableViewValues;
+
+/**
+ * @brief Retains the given TableViewValues, which may be `NULL`.
+ */
+static TableViewValues *retainValues(TableViewValues *values) {
+
+	if (values) {
+		SDL_AtomicIncRef(&values->referenceCount);
+	}
+
+	return values;
+}
+
+/**
+ * @brief Releases the given TableViewValues, which may be `NULL`, freeing them if they are no
+ * longer referenced.
+ */
+static void releaseValues(TableViewValues *values) {
+
+	if (values && SDL_AtomicDecRef(&values->referenceCount)) {
+
+		for (size_t i = 0; i < values->numberOfColumns; i++) {
+			free(values->columns[i]);
+		}
+
+		free(values->columns);
+		free(values);
+	}
+}
+
+/**
+ * @brief A filter-and-sort job, processed by the TableView's worker thread.
+ * @remarks Values are read from a TableViewValues snapshot, so that the worker thread need not call
+ * the data source.
+ */
+typedef struct TableViewFilterJob {
+
+	/**
+	 * @brief Set when the job is superseded by a newer job.
+	 */
+	SDL_atomic_t cancelled;
+
+	/**
+	 * @brief The generation of the TableView's rows at submission.
+	 */
+	unsigned generation;
+
+	/**
+	 * @brief The Predicate and its query.
+	 */
+	Predicate predicate;
+	char *query;
+
+	/**
+	 * @brief The ascending data source indexes of the candidate rows, or `NULL` for all rows.
+	 */
+	size_t *rows;
+	size_t count;
+
+	/**
+	 * @brief The retained snapshot of values.
+	 */
+	TableViewValues *snapshot;
+
+	/**
+	 * @brief The values of each filtered column for all rows, from `snapshot`.
+	 */
+	const ident **columns;
+	size_t numberOfColumns;
+
+	/**
+	 * @brief The sort column's Comparator, order and values for all rows, from `snapshot`.
+	 */
+	Comparator comparator;
+	Order order;
+	const ident *sortValues;
+
+	/**
+	 * @brief The resulting row mapping.
+	 */
+	size_t *mapping;
+	size_t mappingCount;
+} TableViewFilterJob;
+
+/**
+ * @brief The background filter-and-sort pipeline of a TableView.
+ */
+struct TableViewFilter {
+
+	/**
+	 * @brief The filter column, or `NULL` for all columns.
+	 */
+	TableColumn *column;
+
+	/**
+	 * @brief The Predicate and the current query, or `NULL` if not filtering.
+	 */
+	Predicate predicate;
+	char *query;
+
+	/**
+	 * @brief The query of the presented row mapping, or `NULL` if it is not a filter result.
+	 */
+	char *matchedQuery;
+
+	/**
+	 * @brief Incremented whenever the rows or the filter change, invalidating jobs in progress.
+	 */
+	unsigned generation;
+
+	/**
+	 * @brief The snapshot of values, or `NULL` until a job needs it.
+	 */
+	TableViewValues *values;
+
+	/**
+	 * @brief True while a submitted job has not yet been applied.
+	 */
+	_Bool isFiltering;
+
+	/**
+	 * @brief The worker thread, its lock and condition.
+	 */
+	SDL_Thread *thread;
+	SDL_mutex *lock;
+	SDL_cond *condition;
+
+	/**
+	 * @brief The pending, running and finished jobs, guarded by `lock`.
+	 */
+	TableViewFilterJob *pending, *running, *result;
+
+	/**
+	 * @brief Set to stop the worker thread.
+	 */
+	_Bool quit;
+};
+
+/**
+ * @brief Frees the given TableViewFilterJob.
+ */
+static void freeFilterJob(TableViewFilterJob *job) {
+
+	if (job) {
+		free(job->query);
+		free(job->rows);
+		free(job->columns);
+		free(job->mapping);
+
+		releaseValues(job->snapshot);
+
+		free(job);
+	}
+}
+
+/**
+ * @brief Filters and sorts the candidate rows of the given job.
+ */
+static void runFilterJob(TableViewFilterJob *job) {
+
+	job->mapping = calloc(job->count + 1, sizeof(size_t));
+	assert(job->mapping);
+
+	for (size_t i = 0; i < job->count; i++) {
+
+		if ((i & 0x3ff) == 0 && SDL_AtomicGet(&job->cancelled)) {
+			return;
+		}
+
+		const size_t row = job->rows ? job->rows[i] : i;
+
+		for (size_t j = 0; j < job->numberOfColumns; j++) {
+			if (job->predicate(job->columns[j][row], job->query)) {
+				job->mapping[job->mappingCount++] = row;
+				break;
+			}
+		}
+	}
+
+	if (job->sortValues && job->mappingCount && SDL_AtomicGet(&job->cancelled) == 0) {
+
+		SortKey *keys = calloc(job->mappingCount, sizeof(SortKey));
+		assert(keys);
+
+		for (size_t i = 0; i < job->mappingCount; i++) {
+			keys[i].value = job->sortValues[job->mapping[i]];
+			keys[i].row = job->mapping[i];
+		}
+
+		_sortComparator = job->comparator;
+		_sortOrder = job->order;
+
+		qsort(keys, job->mappingCount, sizeof(SortKey), sortRows_compare);
+
+		for (size_t i = 0; i < job->mappingCount; i++) {
+			job->mapping[i] = keys[i].row;
+		}
+
+		free(keys);
+	}
+}
+
+/**
+ * @brief The worker thread, which runs pending jobs until the filter quits.
+ */
+static int filterThread(void *data) {
+
+	TableViewFilter *filter = data;
+
+	SDL_LockMutex(filter->lock);
+
+	while (true) {
+
+		while (filter->pending == NULL && filter->quit == false) {
+			SDL_CondWait(filter->condition, filter->lock);
+		}
+
+		if (filter->quit) {
+			break;
+		}
+
+		TableViewFilterJob *job = filter->running = filter->pending;
+		filter->pending = NULL;
+
+		SDL_UnlockMutex(filter->lock);
+
+		runFilterJob(job);
+
+		SDL_LockMutex(filter->lock);
+
+		filter->running = NULL;
+
+		if (SDL_AtomicGet(&job->cancelled)) {
+			freeFilterJob(job);
+		} else {
+			freeFilterJob(filter->result);
+			filter->result = job;
+		}
+	}
+
+	SDL_UnlockMutex(filter->lock);
+
+	return 0;
+}
+
+/**
+ * @return The values of the given column for all rows, from the snapshot, gathering them if needed.
+ */
+static const ident *columnValues(TableView *self, const TableColumn *column) {
+
+	TableViewFilter *filter = self->filter;
+
+	const Array *columns = (Array *) self->columns;
+
+	const ssize_t index = $(columns, indexOfObject, (ident) column);
+	assert(index > -1);
+
+	if (filter->values == NULL) {
+
+		filter->values = calloc(1, sizeof(TableViewValues));
+		assert(filter->values);
+
+		SDL_AtomicSet(&filter->values->referenceCount, 1);
+
+		filter->values->numberOfColumns = columns->count;
+		filter->values->numberOfRows = self->numberOfRows;
+
+		filter->values->columns = calloc(columns->count, sizeof(ident *));
+		assert(filter->values->columns);
+	}
+
+	ident **values = filter->values->columns + index;
+	if (*values == NULL) {
+
+		*values = calloc(self->numberOfRows + 1, sizeof(ident));
+		assert(*values);
+
+		valuesForColumnInRange(self, column, (Range) { .location = 0, .length = self->numberOfRows }, *values);
+	}
+
+	return *values;
+}
+
+/**
+ * @brief Discards the snapshot of values after a change to the rows or the columns.
+ */
+static void invalidateValues(TableView *self) {
+
+	TableViewFilter *filter = self->filter;
+
+	releaseValues(filter->values);
+	filter->values = NULL;
+}
+
+/**
+ * @brief Cancels any pending, running or finished jobs.
+ */
+static void cancelFilter(TableView *self) {
+
+	TableViewFilter *filter = self->filter;
+
+	SDL_LockMutex(filter->lock);
+
+	if (filter->running) {
+		SDL_AtomicSet(&filter->running->cancelled, 1);
+	}
+
+	freeFilterJob(filter->pending);
+	filter->pending = NULL;
+
+	freeFilterJob(filter->result);
+	filter->result = NULL;
+
+	SDL_UnlockMutex(filter->lock);
+
+	filter->isFiltering = false;
+}
+
+/**
+ * @return True if the row at the given index satisfies the filter, false otherwise.
+ * @remarks This function is used for rows that are inserted or reloaded while filtering.
+ */
+static _Bool filterRow(const TableView *self, size_t index) {
+
+	const TableViewFilter *filter = self->filter;
+
+	if (filter->query) {
+
+		const Array *columns = (Array *) self->columns;
+		for (size_t i = 0; i < columns->count; i++) {
+
+			const TableColumn *column = $(columns, objectAtIndex, i);
+			if (filter->column && filter->column != column) {
+				continue;
+			}
+
+			ident value;
+			valuesForColumnInRange(self, column, (Range) { .location = index, .length = 1 }, &value);
+
+			if (filter->predicate(value, filter->query)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Compares the rows at the given indexes as the row mapping orders them: by the sort
+ * column, if any, and then by data source index.
+ */
+static Order compareMappedRows(const TableView *self, size_t row1, size_t row2) {
+
+	const TableColumn *column = self->sortColumn;
+	if (column && column->comparator) {
+
+		ident value1, value2;
+		valuesForColumnInRange(self, column, (Range) { .location = row1, .length = 1 }, &value1);
+		valuesForColumnInRange(self, column, (Range) { .location = row2, .length = 1 }, &value2);
+
+		const Order order = compareValues(column->comparator, column->order, value1, value2);
+		if (order != OrderSame) {
+			return order;
+		}
+	}
+
+	return row1 < row2 ? OrderAscending : row1 > row2 ? OrderDescending : OrderSame;
+}
+
+/**
+ * @return True if the row mapping remains valid for the row at the given index after its values
+ * changed: the row is presented if and only if it satisfies the filter, and in order with its
+ * neighbors.
+ */
+static _Bool isRowMappingValid(const TableView *self, size_t index) {
+
+	const ssize_t position = positionOfRow(self, index);
+
+	if (filterRow(self, index) == false) {
+		return position == -1;
+	}
+
+	if (position == -1) {
+		return false;
+	}
+
+	if (position > 0 && compareMappedRows(self, self->rowMapping[position - 1], index) != OrderAscending) {
+		return false;
+	}
+
+	if ((size_t) position + 1 < self->rowMappingCount && compareMappedRows(self, index, self->rowMapping[position + 1]) != OrderAscending) {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Submits a job to filter and sort the rows on the worker thread, superseding any job in
+ * progress.
+ * @param refine True to filter only the currently presented rows.
+ */
+static void submitFilter(TableView *self, _Bool refine) {
+
+	TableViewFilter *filter = self->filter;
+
+	TableViewFilterJob *job = calloc(1, sizeof(TableViewFilterJob));
+	assert(job);
+
+	job->generation = filter->generation;
+	job->predicate = filter->predicate;
+	job->query = strdup(filter->query);
+
+	if (refine && self->rowMapping) {
+		job->rows = calloc(self->rowMappingCount + 1, sizeof(size_t));
+		assert(job->rows);
+
+		memcpy(job->rows, self->rowMapping, self->rowMappingCount * sizeof(size_t));
+		qsort(job->rows, self->rowMappingCount, sizeof(size_t), compareIndexes);
+
+		job->count = self->rowMappingCount;
+	} else {
+		job->count = self->numberOfRows;
+	}
+
+	const Array *columns = (Array *) self->columns;
+
+	job->columns = calloc(columns->count + 1, sizeof(ident *));
+	assert(job->columns);
+
+	for (size_t i = 0; i < columns->count; i++) {
+
+		const TableColumn *column = $(columns, objectAtIndex, i);
+		if (filter->column && filter->column != column) {
+			continue;
+		}
+
+		job->columns[job->numberOfColumns++] = columnValues(self, column);
+	}
+
+	const TableColumn *sortColumn = self->sortColumn;
+	if (sortColumn && sortColumn->comparator) {
+
+		job->comparator = sortColumn->comparator;
+		job->order = sortColumn->order;
+
+		job->sortValues = columnValues(self, sortColumn);
+	}
+
+	job->snapshot = retainValues(filter->values);
+
+	SDL_LockMutex(filter->lock);
+
+	if (filter->thread == NULL) {
+		filter->thread = SDL_CreateThread(filterThread, "TableView", filter);
+		assert(filter->thread);
+	}
+
+	if (filter->running) {
+		SDL_AtomicSet(&filter->running->cancelled, 1);
+	}
+
+	freeFilterJob(filter->pending);
+	filter->pending = job;
+
+	SDL_CondSignal(filter->condition);
+	SDL_UnlockMutex(filter->lock);
+
+	filter->isFiltering = true;
+}
+
+/**
+ * @brief Presents the result of the most recently finished job, if it remains valid.
+ */
+static void applyFilter(TableView *self) {
+
+	TableViewFilter *filter = self->filter;
+
+	SDL_LockMutex(filter->lock);
+
+	TableViewFilterJob *job = filter->result;
+	filter->result = NULL;
+
+	SDL_UnlockMutex(filter->lock);
+
+	if (job) {
+		if (job->generation == filter->generation) {
+
+			cancelPrefetching(self);
+
+			free(self->rowMapping);
+
+			self->rowMapping = job->mapping;
+			self->rowMappingCount = job->mappingCount;
+
+			job->mapping = NULL;
+
+			buildRowPositions(self);
+
+			free(filter->matchedQuery);
+			filter->matchedQuery = strdup(job->query);
+
+			filter->isFiltering = false;
+
+			buildRowHeightTree(self);
+
+			self->control.view.needsLayout = true;
+		}
+
+		freeFilterJob(job);
+	}
+}
+
+/**
+ * @brief Invalidates any job in progress after a change to the rows, resubmitting it if needed.
+ */
+static void rowsDidChange(TableView *self) {
+
+	TableViewFilter *filter = self->filter;
+
+	filter->generation++;
+
+	invalidateValues(self);
+
+	if (filter->isFiltering) {
+		submitFilter(self, false);
+	}
+}
+
+/**
+ * @return The index of the column at the given offset, which may be beyond the last column.
+ */
+static size_t columnAtOffset(const TableView *self, int offset) {
+
+	const size_t count = ((Array *) self->columns)->count;
+
+	if (self->columnOffsets == NULL || offset < 0) {
+		return 0;
+	}
+
+	size_t low = 0, high = count + 1;
+	while (low < high) {
+		const size_t mid = (low + high) >> 1;
+		if (self->columnOffsets[mid] <= offset) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low - 1;
+}
+
+/**
+ * @brief Discards the cached column offsets, so that they are computed again at the next layout.
+ */
+static void invalidateColumnOffsets(TableView *self) {
+
+	free(self->columnOffsets);
+	self->columnOffsets = NULL;
+}
+
+/**
+ * @brief Updates the range of visible columns, and the header cells presenting them.
+ */
+static void layoutVisibleColumns(TableView *self) {
+
+	const Array *columns = (Array *) self->columns;
+	const size_t count = columns->count;
+
+	const SDL_Rect bounds = $((View *) self->scrollView, bounds);
+	const int offset = max(-self->scrollView->contentOffset.x, 0);
+
+	const size_t first = min(columnAtOffset(self, offset), count);
+	const size_t last = min(columnAtOffset(self, offset + bounds.w) + 1, count);
+
+	const Range range = { .location = first, .length = last - first };
+
+	if (range.location != self->visibleColumnRange.location || range.length != self->visibleColumnRange.length) {
+
+		TableRowView *headerView = (TableRowView *) self->headerView;
+
+		$(headerView, removeAllCells);
+
+		for (size_t i = first; i < last; i++) {
+			const TableColumn *column = $(columns, objectAtIndex, i);
+			$(headerView, addCell, (TableCellView *) column->headerCell);
+		}
+
+		headerView->columnRange = range;
+		headerView->stackView.view.needsLayout = true;
+
+		self->visibleColumnRange = range;
+	}
+}
+
+/**
+ * @brief Updates the shared column geometry and the range of visible columns.
+ * @remarks Columns narrower in total than the table are scaled to fill it. Otherwise, they are
+ * presented at their natural widths, and scroll horizontally. The column offsets are cached until
+ * the columns or the width of the table change.
+ */
+static void layoutColumns(TableView *self) {
+
+	const SDL_Rect bounds = $((View *) self->scrollView, bounds);
+
+	if (self->columnOffsets == NULL || self->columnOffsetsWidth != bounds.w) {
+
+		const Array *columns = (Array *) self->columns;
+		const size_t count = columns->count;
+
+		int *offsets = calloc(count + 1, sizeof(int));
+		assert(offsets);
+
+		int requestedSize = 0;
+		for (size_t i = 0; i < count; i++) {
+			const TableColumn *column = $(columns, objectAtIndex, i);
+			requestedSize += column->width;
+		}
+
+		const int availableSize = bounds.w - (count ? self->cellSpacing * (int) (count - 1) : 0);
+		const float scale = requestedSize && requestedSize < availableSize ? availableSize / (float) requestedSize : 1.0;
+
+		int x = 0;
+		for (size_t i = 0; i < count; i++) {
+			const TableColumn *column = $(columns, objectAtIndex, i);
+
+			offsets[i] = x;
+			x += column->width * scale + self->cellSpacing;
+		}
+
+		offsets[count] = x;
+
+		_Bool geometryChanged = true;
+		if (self->columnOffsets) {
+			geometryChanged = memcmp(self->columnOffsets, offsets, (count + 1) * sizeof(int)) != 0;
+		}
+
+		free(self->columnOffsets);
+		self->columnOffsets = offsets;
+		self->columnOffsetsWidth = bounds.w;
+
+		if (geometryChanged) {
+
+			((View *) self->headerView)->needsLayout = true;
+
+			const Array *rows = (Array *) self->rows;
+			for (size_t i = 0; i < rows->count; i++) {
+
+				View *row = $(rows, objectAtIndex, i);
+				row->needsLayout = true;
+			}
+		}
+	}
 
-#include <Objectively/String.h>
+	layoutVisibleColumns(self);
+}
 
-#include <ObjectivelyMVC/TableView.h>
+/**
+ * @return The column whose right edge is at the given point, within the resize margin, or `NULL`.
+ */
+static TableColumn *columnToResizeAtPoint(const TableView *self, const SDL_Point *point) {
 
-#define _Class _TableView
+	const Array *columns = (Array *) self->columns;
+
+	if (self->columnOffsets && columns->count) {
+
+		const SDL_Rect frame = $((View *) self, renderFrame);
+		const int x = point->x - frame.x - self->control.view.padding.left - self->scrollView->contentOffset.x;
+
+		const size_t index = min(columnAtOffset(self, x), columns->count - 1);
+
+		for (ssize_t i = index; i >= 0 && i + 1 >= (ssize_t) index; i--) {
+
+			const int edge = self->columnOffsets[i + 1] - self->cellSpacing;
+			if (abs(x - edge) <= TABLE_VIEW_COLUMN_RESIZE_MARGIN) {
+				return $(columns, objectAtIndex, i);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Discards the column geometry after a change to the columns, and lays them out again.
+ */
+static void invalidateColumns(TableView *self) {
+
+	invalidateColumnOffsets(self);
+
+	self->visibleColumnRange = (Range) { .location = -1, .length = 0 };
+
+	layoutColumns(self);
+}
+
+/**
+ * @brief Populates the given TableRowView with cells for the row at the given index.
+ * @remarks Rows that are not yet ready are populated with placeholder cells.
+ */
+static void populateRow(TableView *self, TableRowView *row, size_t index) {
+
+	row->index = index;
+	row->columnRange = self->visibleColumnRange;
+
+	_Bool isReady = true;
+	if (self->dataSource.isRowReady) {
+		isReady = self->dataSource.isRowReady(self, index);
+	}
+
+	const Array *columns = (Array *) self->columns;
+	for (size_t i = 0; i < row->columnRange.length; i++) {
+		const TableColumn *column = $(columns, objectAtIndex, row->columnRange.location + i);
+		if (column->formatter) {
+			continue;
+		}
+
+		TableCellView *cell;
+		if (isReady) {
+			cell = self->delegate.cellForColumnAndRow(self, column, index);
+		} else {
+			cell = $(alloc(TableCellView), initWithFrame, NULL);
+		}
+
+		assert(cell);
+
+		$(row, addCell, cell);
+		release(cell);
+	}
+}
+
+/**
+ * @brief Repopulates the visible rows whose indexes are in the given IndexSet.
+ */
+static void repopulateRows(TableView *self, const IndexSet *indexes) {
+
+	const Array *rows = (Array *) self->rows;
+	for (size_t i = 0; i < rows->count; i++) {
+
+		TableRowView *row = $(rows, objectAtIndex, i);
+		if (row->index > -1) {
+
+			const size_t position = searchIndexes(indexes->indexes, indexes->count, row->index);
+			if (position < indexes->count && indexes->indexes[position] == (size_t) row->index) {
+
+				$(row, removeAllCells);
+				populateRow(self, row, row->index);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Invalidates all visible rows, so that they are recycled on the next layout pass.
+ */
+static void invalidateRows(TableView *self) {
+
+	const Array *rows = (Array *) self->rows;
+	for (size_t i = 0; i < rows->count; i++) {
+
+		TableRowView *row = $(rows, objectAtIndex, i);
+		row->index = -1;
+	}
+
+	cancelPrefetching(self);
+
+	self->control.view.needsLayout = true;
+}
+
+/**
+ * @brief Notifies the delegate of rows entering and leaving the prefetch range.
+ */
+static void prefetchRows(TableView *self) {
+
+	if (self->delegate.prefetchRowsAtIndexes == NULL && self->delegate.cancelPrefetchingForRowsAtIndexes == NULL) {
+		return;
+	}
+
+	const size_t distance = max(self->prefetchDistance, 0);
+	const size_t first = self->visibleRange.location;
+	const size_t last = first + self->visibleRange.length;
+
+	const Range range = {
+		.location = first > distance ? first - distance : 0,
+		.length = min(last + distance, numberOfPresentedRows(self)) - (first > distance ? first - distance : 0)
+	};
+
+	const Range previous = self->prefetchRange;
+	if (range.location == previous.location && range.length == previous.length) {
+		return;
+	}
+
+	if (self->delegate.cancelPrefetchingForRowsAtIndexes) {
+		IndexSet *indexes = prefetchRows_indexes(self, previous, range);
+		if (indexes) {
+			self->delegate.cancelPrefetchingForRowsAtIndexes(self, indexes);
+			release(indexes);
+		}
+	}
+
+	if (self->delegate.prefetchRowsAtIndexes) {
+		IndexSet *indexes = prefetchRows_indexes(self, range, previous);
+		if (indexes) {
+			self->delegate.prefetchRowsAtIndexes(self, indexes);
+			release(indexes);
+		}
+	}
+
+	self->prefetchRange = range;
+}
+
+/**
+ * @brief Instantiates, recycles and positions the TableRowViews within the visible range.
+ */
+static void layoutRows(TableView *self) {
+
+	const View *scrollView = (View *) self->scrollView;
+	const int offset = max(-self->scrollView->contentOffset.y, 0);
+
+	const size_t numberOfRows = numberOfPresentedRows(self);
+
+	const size_t first = min(positionAtOffset(self, offset), numberOfRows);
+	const size_t last = min(positionAtOffset(self, offset + scrollView->frame.h) + 1, numberOfRows);
+	const size_t count = last - first;
+
+	TableRowView **visibleRows = calloc(count + 1, sizeof(TableRowView *));
+	assert(visibleRows);
+
+	const Array *rows = (Array *) self->rows;
+	for (ssize_t i = rows->count - 1; i >= 0; i--) {
+
+		TableRowView *row = $(rows, objectAtIndex, i);
+
+		const ssize_t position = row->index > -1 ? positionOfRow(self, row->index) : -1;
+
+		if (position >= (ssize_t) first && position < (ssize_t) last && visibleRows[position - first] == NULL) {
+			visibleRows[position - first] = row;
+		} else {
+			$((View *) row, removeFromSuperview);
+			$(row, removeAllCells);
+
+			row->index = -1;
+
+			$(self->reusableRows, addObject, row);
+			$(self->rows, removeObjectAtIndex, i);
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (visibleRows[i] == NULL) {
+
+			TableRowView *row = $((Array *) self->reusableRows, lastObject);
+			if (row) {
+				retain(row);
+				$(self->reusableRows, removeLastObject);
+			} else {
+				row = $(alloc(TableRowView), initWithTableView, self);
+				assert(row);
+			}
+
+			row->stackView.view.concurrentLayout = self->concurrentRowLayout;
+
+			populateRow(self, row, rowAtPosition(self, first + i));
+
+			$(self->rows, addObject, row);
+			$(self->contentView, addSubview, (View *) row);
+
+			release(row);
+
+			visibleRows[i] = row;
+		}
+	}
+
+	for (size_t i = 0; i < count; i++) {
+
+		TableRowView *row = visibleRows[i];
+		const size_t position = first + i;
+
+		row->stackView.view.frame.x = 0;
+		row->stackView.view.frame.y = rowOffset(self, position);
+		row->stackView.view.frame.h = rowHeightAtPosition(self, position);
+
+		if (self->usesAlternateBackgroundColor && (position & 1)) {
+			row->assignedBackgroundColor = self->alternateBackgroundColor;
+		} else {
+			row->assignedBackgroundColor = Colors.Clear;
+		}
+
+		const Range columnRange = self->visibleColumnRange;
+		if (row->columnRange.location != columnRange.location || row->columnRange.length != columnRange.length) {
+
+			$(row, removeAllCells);
+			populateRow(self, row, row->index);
+
+			row->stackView.view.needsLayout = true;
+		}
+
+		$(row, setSelected, isRowSelected(self, row->index));
+	}
+
+	free(visibleRows);
+
+	self->visibleRange = (Range) { .location = first, .length = count };
+
+	prefetchRows(self);
+}
+
+/**
+ * @brief ScrollViewDelegate callback, which lays out the rows that have scrolled into view.
+ * @remarks Only the row container is invalidated. The TableView itself is laid out again only if
+ * it has never been laid out.
+ */
+static void didScroll(ScrollView *scrollView) {
+
+	TableView *this = (TableView *) scrollView->delegate.self;
+
+	if (this->columnOffsets) {
+
+		layoutVisibleColumns(this);
+		layoutRows(this);
+
+		this->contentView->needsLayout = true;
+	} else {
+		this->control.view.needsLayout = true;
+	}
+}
 
 #pragma mark - Object
 
@@ -38,9 +1720,52 @@ static void dealloc(Object *self) {
 
 	TableView *this = (TableView *) self;
 
+	TableViewFilter *filter = this->filter;
+
+	SDL_LockMutex(filter->lock);
+
+	filter->quit = true;
+
+	if (filter->running) {
+		SDL_AtomicSet(&filter->running->cancelled, 1);
+	}
+
+	SDL_CondSignal(filter->condition);
+	SDL_UnlockMutex(filter->lock);
+
+	if (filter->thread) {
+		SDL_WaitThread(filter->thread, NULL);
+	}
+
+	freeFilterJob(filter->pending);
+	freeFilterJob(filter->result);
+
+	releaseValues(filter->values);
+
+	SDL_DestroyCond(filter->condition);
+	SDL_DestroyMutex(filter->lock);
+
+	release(filter->column);
+
+	free(filter->matchedQuery);
+	free(filter->query);
+	free(filter);
+
+	free(this->columnOffsets);
+	free(this->rowHeights);
+	free(this->rowHeightTree);
+	free(this->rowMapping);
+	free(this->rowPositions);
+	free(this->rowRuns);
+	free(this->selection);
+
+	SDL_DestroyMutex(this->readyLock);
+
 	release(this->columns);
 	release(this->contentView);
 	release(this->headerView);
+	release(this->readyRows);
+	release(this->reusableRows);
 	release(this->rows);
 	release(this->scrollView);
 
@@ -85,12 +1810,16 @@ static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
 	const Inlet inlets[] = MakeInlets(
 		MakeInlet("alternateBackgroundColor", InletTypeColor, &this->alternateBackgroundColor, NULL),
 		MakeInlet("cellSpacing", InletTypeInteger, &this->cellSpacing, NULL),
+		MakeInlet("concurrentRowLayout", InletTypeBool, &this->concurrentRowLayout, NULL),
+		MakeInlet("prefetchDistance", InletTypeInteger, &this->prefetchDistance, NULL),
 		MakeInlet("rowHeight", InletTypeInteger, &this->rowHeight, NULL),
 		MakeInlet("usesAlternateBackgroundColor", InletTypeBool, &this->usesAlternateBackgroundColor, NULL)
 	);
 
 	$(self, bind, dictionary, inlets);
 
+	invalidateColumnOffsets(this);
+
 	const Array *columns = $(dictionary, objectForKeyPath, "columns");
 	if (columns) {
 		$(columns, enumerateObjects, awakeWithDictionary_columns, self);
@@ -116,20 +1845,15 @@ static void layoutSubviews(View *self) {
 	scrollView->frame = $(this, scrollableArea);
 	scrollView->needsLayout = true;
 
-	const Array *rows = (Array *) this->rows;
-	for (size_t i = 0; i < rows->count; i++) {
+	layoutColumns(this);
 
-		TableRowView *row = (TableRowView *) $(rows, objectAtIndex, i);
-		row->stackView.view.frame.h = this->rowHeight;
+	const size_t numberOfColumns = ((Array *) this->columns)->count;
+	const int width = this->columnOffsets[numberOfColumns] - (numberOfColumns ? this->cellSpacing : 0);
 
-		if (this->usesAlternateBackgroundColor && (i & 1)) {
-			row->assignedBackgroundColor = this->alternateBackgroundColor;
-		} else {
-			row->assignedBackgroundColor = Colors.Clear;
-		}
+	this->contentView->frame.w = max(width, scrollView->frame.w);
+	this->contentView->frame.h = rowOffset(this, numberOfPresentedRows(this));
 
-		row->stackView.view.backgroundColor = row->assignedBackgroundColor;
-	}
+	layoutRows(this);
 
 	super(View, self, layoutSubviews);
 }
@@ -142,9 +1866,39 @@ static SDL_Size sizeThatFits(const View *self) {
 	const TableView *this = (TableView *) self;
 
 	const SDL_Size headerSize = $((View *) this->headerView, sizeThatFits);
-	const SDL_Size contentSize = $((View *) this->contentView, sizeThatFits);
 
-	return MakeSize(max(headerSize.w, contentSize.w), headerSize.h + contentSize.h);
+	return MakeSize(headerSize.w, headerSize.h + rowOffset(this, numberOfPresentedRows(this)));
+}
+
+/**
+ * @see View::willLayoutSubviews(View *)
+ */
+static void willLayoutSubviews(View *self) {
+
+	TableView *this = (TableView *) self;
+
+	Array *readyRows = NULL;
+
+	SDL_LockMutex(this->readyLock);
+
+	if (this->readyRows->array.count) {
+		readyRows = (Array *) $((Object *) this->readyRows, copy);
+		$(this->readyRows, removeAllObjects);
+	}
+
+	SDL_UnlockMutex(this->readyLock);
+
+	if (readyRows) {
+		for (size_t i = 0; i < readyRows->count; i++) {
+			repopulateRows(this, $(readyRows, objectAtIndex, i));
+		}
+
+		release(readyRows);
+	}
+
+	applyFilter(this);
+
+	super(View, self, willLayoutSubviews);
 }
 
 #pragma mark - Control
@@ -156,6 +1910,34 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
 
 	TableView *this = (TableView *) self;
 
+	if (event->type == SDL_MOUSEBUTTONDOWN && (event->button.button & SDL_BUTTON_LMASK)) {
+
+		if ($((View *) this->headerView, didReceiveEvent, event)) {
+
+			const SDL_Point point = {
+				.x = event->button.x,
+				.y = event->button.y
+			};
+
+			TableColumn *column = columnToResizeAtPoint(this, &point);
+			if (column) {
+				this->resizingColumn = column;
+				this->resizingOrigin = point.x;
+				this->resizingWidth = column->width;
+				return true;
+			}
+		}
+	} else if (event->type == SDL_MOUSEMOTION && this->resizingColumn) {
+
+		$(this, resizeColumn, this->resizingColumn, this->resizingWidth + event->motion.x - this->resizingOrigin);
+		return true;
+
+	} else if (event->type == SDL_MOUSEBUTTONUP && this->resizingColumn) {
+
+		this->resizingColumn = NULL;
+		return true;
+	}
+
 	if (event->type == SDL_MOUSEBUTTONUP) {
 
 		if ($((View *) this->headerView, didReceiveEvent, event)) {
@@ -183,31 +1965,35 @@ static _Bool captureEvent(Control *self, const SDL_Event *event) {
 				};
 
 				const ssize_t index = $(this, rowAtPoint, &point);
-
-				const Array *rows = (Array *) this->rows;
-				if (index > -1 && index < rows->count) {
-
-					TableRowView *row = $(rows, objectAtIndex, index);
+				if (index > -1) {
 
 					switch (this->control.selection) {
 						case ControlSelectionNone:
 							break;
 						case ControlSelectionSingle:
-							if (row->isSelected == false) {
+							if (isRowSelected(this, index) == false) {
 								$(this, deselectAll);
 								$(this, selectRowAtIndex, index);
 							}
+							this->selectionAnchor = index;
 							break;
 						case ControlSelectionMultiple:
-							if (SDL_GetModState() & (KMOD_CTRL | KMOD_GUI)) {
-								if (row->isSelected) {
+							if ((SDL_GetModState() & KMOD_SHIFT) && this->selectionAnchor > -1) {
+								if ((SDL_GetModState() & (KMOD_CTRL | KMOD_GUI)) == 0) {
+									$(this, deselectAll);
+								}
+								selectRowsBetween(this, this->selectionAnchor, index);
+							} else if (SDL_GetModState() & (KMOD_CTRL | KMOD_GUI)) {
+								if (isRowSelected(this, index)) {
 									$(this, deselectRowAtIndex, index);
 								} else {
 									$(this, selectRowAtIndex, index);
 								}
+								this->selectionAnchor = index;
 							} else {
 								$(this, deselectAll);
 								$(this, selectRowAtIndex, index);
+								this->selectionAnchor = index;
 							}
 							break;
 					}
@@ -241,6 +2027,10 @@ static void addColumn(TableView *self, TableColumn *column) {
 	assert(column);
 
 	$(self->columns, addObject, column);
+
+	invalidateColumns(self);
+	invalidateValues(self);
+	invalidateRows(self);
 }
 
 /**
@@ -252,49 +2042,157 @@ static TableColumn *columnAtPoint(const TableView *self, const SDL_Point *point)
 	const SDL_Rect frame = $((View *) self, renderFrame);
 	if (SDL_PointInRect(point, &frame)) {
 
-		int x = frame.x + self->control.view.padding.left;
+		const int x = point->x - frame.x - self->control.view.padding.left - self->scrollView->contentOffset.x;
 
-		Array *columns = (Array *) self->columns;
-		for (size_t i = 0; i < columns->count; i++) {
+		const size_t index = columnAtOffset(self, x);
+		if (index < ((Array *) self->columns)->count) {
+			return $((Array *) self->columns, objectAtIndex, index);
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @fn TableColumn *TableView::columnWithIdentifier(const TableView *self, const char *identifier)
+ * @memberof TableView
+ */
+static TableColumn *columnWithIdentifier(const TableView *self, const char *identifier) {
+
+	assert(identifier);
+
+	const Array *columns = (Array *) self->columns;
+	for (size_t i = 0; i < columns->count; i++) {
+
+		TableColumn *column = $(columns, objectAtIndex, i);
+		if (strcmp(identifier, column->identifier) == 0) {
+			return column;
+		}
+	}
+
+	return NULL;
+}
 
-			TableColumn *column = $(columns, objectAtIndex, i);
+/**
+ * @return The index of the row at `index` after the deletion of the rows at `indexes`, or `-1`
+ * if the row was deleted.
+ */
+static ssize_t deleteRowsAtIndexes_shift(const IndexSet *indexes, size_t index) {
+
+	const size_t position = searchIndexes(indexes->indexes, indexes->count, index);
+	if (position < indexes->count && indexes->indexes[position] == index) {
+		return -1;
+	}
+
+	return index - position;
+}
+
+/**
+ * @brief Applies deleteRowsAtIndexes_shift to the given indexes, removing those deleted.
+ * @return The count of the remaining indexes.
+ */
+static size_t deleteRowsAtIndexes_compact(const IndexSet *indexes, size_t *array, size_t count) {
+
+	size_t j = 0;
+	for (size_t i = 0; i < count; i++) {
+		const ssize_t index = deleteRowsAtIndexes_shift(indexes, array[i]);
+		if (index > -1) {
+			array[j++] = index;
+		}
+	}
+
+	return j;
+}
+
+/**
+ * @brief Removes the rows at the given indexes from the selection, shifting the remaining ranges.
+ */
+static void deleteRowsAtIndexes_selection(TableView *self, const IndexSet *indexes) {
+
+	size_t count = 0;
+	for (size_t i = 0; i < self->selectionCount; i++) {
+
+		const size_t start = self->selection[i].location;
+		const size_t end = start + self->selection[i].length;
 
-			if (x + column->width + self->cellSpacing >= point->x) {
-				return column;
+		const size_t before = searchIndexes(indexes->indexes, indexes->count, start);
+		const size_t within = searchIndexes(indexes->indexes, indexes->count, end) - before;
+
+		const Range range = { .location = start - before, .length = end - start - within };
+		if (range.length) {
+
+			Range *previous = count ? self->selection + count - 1 : NULL;
+			if (previous && previous->location + (ssize_t) previous->length == range.location) {
+				previous->length += range.length;
+			} else {
+				self->selection[count++] = range;
 			}
+		}
+	}
 
-			x += column->width + self->cellSpacing;
+	self->selectionCount = count;
+}
+
+/**
+ * @brief Removes the heights of the rows at the given indexes.
+ */
+static void deleteRowsAtIndexes_heights(TableView *self, const IndexSet *indexes) {
+
+	if (self->rowHeights) {
+
+		size_t count = 0;
+		for (size_t i = 0, j = 0; i < self->numberOfRows; i++) {
+			while (j < indexes->count && indexes->indexes[j] < i) {
+				j++;
+			}
+			if (j == indexes->count || indexes->indexes[j] != i) {
+				self->rowHeights[count++] = self->rowHeights[i];
+			}
 		}
 	}
-
-	return NULL;
 }
 
 /**
- * @fn TableColumn *TableView::columnWithIdentifier(const TableView *self, const char *identifier)
+ * @fn void TableView::deleteRowsAtIndexes(TableView *self, const IndexSet *indexes)
  * @memberof TableView
  */
-static TableColumn *columnWithIdentifier(const TableView *self, const char *identifier) {
+static void deleteRowsAtIndexes(TableView *self, const IndexSet *indexes) {
 
-	assert(identifier);
+	if (indexes && indexes->count) {
 
-	const Array *columns = (Array *) self->columns;
-	for (size_t i = 0; i < columns->count; i++) {
+		cancelPrefetching(self);
 
-		TableColumn *column = $(columns, objectAtIndex, i);
-		if (strcmp(identifier, column->identifier) == 0) {
-			return column;
+		if (self->rowMapping) {
+			self->rowMappingCount = deleteRowsAtIndexes_compact(indexes, self->rowMapping, self->rowMappingCount);
 		}
-	}
 
-	return NULL;
-}
+		deleteRowsAtIndexes_heights(self, indexes);
 
-/**
- * @brief ArrayEnumerator for all Row deselection.
- */
-static void deselectAll_enumerate(const Array *array, ident obj, ident data) {
-	$((TableRowView *) obj, setSelected, false);
+		self->numberOfRows -= searchIndexes(indexes->indexes, indexes->count, self->numberOfRows);
+
+		buildRowPositions(self);
+
+		deleteRowsAtIndexes_selection(self, indexes);
+
+		if (self->selectionAnchor > -1) {
+			self->selectionAnchor = deleteRowsAtIndexes_shift(indexes, self->selectionAnchor);
+		}
+
+		const Array *rows = (Array *) self->rows;
+		for (size_t i = 0; i < rows->count; i++) {
+
+			TableRowView *row = $(rows, objectAtIndex, i);
+			if (row->index > -1) {
+				row->index = deleteRowsAtIndexes_shift(indexes, row->index);
+			}
+		}
+
+		rowsDidChange(self);
+
+		buildRowHeightTree(self);
+
+		self->control.view.needsLayout = true;
+	}
 }
 
 /**
@@ -302,7 +2200,10 @@ static void deselectAll_enumerate(const Array *array, ident obj, ident data) {
  * @memberof TableView
  */
 static void deselectAll(TableView *self) {
-	$((Array *) self->rows, enumerateObjects, deselectAll_enumerate, NULL);
+
+	self->selectionCount = 0;
+
+	self->control.view.needsLayout = true;
 }
 
 /**
@@ -311,12 +2212,9 @@ static void deselectAll(TableView *self) {
  */
 static void deselectRowAtIndex(TableView *self, size_t index) {
 
-	const Array *rows = (Array *) self->rows;
-	if (index < rows->count) {
+	setRowsSelected(self, index, index + 1, false);
 
-		TableRowView *row = $(rows, objectAtIndex, index);
-		$(row, setSelected, false);
-	}
+	self->control.view.needsLayout = true;
 }
 
 /**
@@ -332,6 +2230,64 @@ static void deselectRowsAtIndexes(TableView *self, const IndexSet *indexes) {
 	}
 }
 
+/**
+ * @fn void TableView::filterRows(TableView *self, TableColumn *column, Predicate predicate, const char *query)
+ * @memberof TableView
+ */
+static void filterRows(TableView *self, TableColumn *column, Predicate predicate, const char *query) {
+
+	TableViewFilter *filter = self->filter;
+
+	cancelFilter(self);
+
+	filter->generation++;
+
+	if (predicate == NULL || query == NULL) {
+
+		release(filter->column);
+		filter->column = NULL;
+
+		filter->predicate = NULL;
+
+		free(filter->query);
+		filter->query = NULL;
+
+		free(filter->matchedQuery);
+		filter->matchedQuery = NULL;
+
+		cancelPrefetching(self);
+
+		sortRows(self);
+
+		buildRowHeightTree(self);
+
+		self->control.view.needsLayout = true;
+		return;
+	}
+
+	_Bool refine = filter->matchedQuery
+		&& filter->column == column
+		&& filter->predicate == predicate
+		&& strncmp(query, filter->matchedQuery, strlen(filter->matchedQuery)) == 0;
+
+	if (filter->column != column) {
+		release(filter->column);
+		filter->column = column ? retain(column) : NULL;
+	}
+
+	filter->predicate = predicate;
+
+	free(filter->query);
+	filter->query = strdup(query);
+
+	if (refine == false) {
+		free(filter->matchedQuery);
+		filter->matchedQuery = NULL;
+	}
+
+	submitFilter(self, refine);
+}
+
 /**
  * @fn TableView *TableView::initWithFrame(TableView *self, const SDL_Rect *frame, ControlStyle style)
  * @memberof TableView
@@ -340,9 +2296,29 @@ static TableView *initWithFrame(TableView *self, const SDL_Rect *frame, ControlS
 
 	self = (TableView *) super(Control, self, initWithFrame, frame, style);
 	if (self) {
+		self->control.view.defersLayoutDuringLiveResize = true;
+
 		self->columns = $$(MutableArray, array);
 		assert(self->columns);
 
+		self->filter = calloc(1, sizeof(TableViewFilter));
+		assert(self->filter);
+
+		self->filter->lock = SDL_CreateMutex();
+		assert(self->filter->lock);
+
+		self->filter->condition = SDL_CreateCond();
+		assert(self->filter->condition);
+
+		self->readyLock = SDL_CreateMutex();
+		assert(self->readyLock);
+
+		self->readyRows = $$(MutableArray, array);
+		assert(self->readyRows);
+
+		self->reusableRows = $$(MutableArray, array);
+		assert(self->reusableRows);
+
 		self->rows = $$(MutableArray, array);
 		assert(self->rows);
 
@@ -351,20 +2327,25 @@ static TableView *initWithFrame(TableView *self, const SDL_Rect *frame, ControlS
 
 		$((View *) self, addSubview, (View *) self->headerView);
 
-		self->contentView = $(alloc(StackView), initWithFrame, NULL);
+		self->contentView = $(alloc(View), initWithFrame, NULL);
 		assert(self->contentView);
 
-		self->contentView->view.autoresizingMask |= ViewAutoresizingWidth;
-
 		self->scrollView = $(alloc(ScrollView), initWithFrame, NULL, style);
 		assert(self->scrollView);
 
 		self->scrollView->control.view.autoresizingMask |= ViewAutoresizingWidth;
 
-		$(self->scrollView, setContentView, (View *) self->contentView);
+		self->scrollView->delegate.self = self;
+		self->scrollView->delegate.didScroll = didScroll;
+
+		$(self->scrollView, setContentView, self->contentView);
 
 		$((View *) self, addSubview, (View *) self->scrollView);
 
+		self->prefetchDistance = DEFAULT_TABLE_VIEW_PREFETCH_DISTANCE;
+
+		self->selectionAnchor = -1;
+
 		if (self->control.style == ControlStyleDefault) {
 
 			self->alternateBackgroundColor = Colors.AlternateColor;
@@ -386,48 +2367,239 @@ static TableView *initWithFrame(TableView *self, const SDL_Rect *frame, ControlS
 }
 
 /**
- * @brief ArrayEnumerator to remove TableRowViews from the table's contentView.
+ * @return The index of the row at `index` after the insertion of rows at `indexes`.
  */
-static void reloadData_removeRows(const Array *array, ident obj, ident data) {
-	$((View *) data, removeSubview, (View *) obj);
+static size_t insertRowsAtIndexes_shift(const IndexSet *indexes, size_t index) {
+
+	size_t low = 0, high = indexes->count;
+	while (low < high) {
+		const size_t mid = (low + high) >> 1;
+		if (indexes->indexes[mid] - mid <= index) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return index + low;
 }
 
-static __thread TableView *_sortTableView;
+/**
+ * @brief Shifts the selection for the insertion of rows at the given indexes, splitting any ranges
+ * that the inserted rows fall within.
+ */
+static void insertRowsAtIndexes_selection(TableView *self, const IndexSet *indexes) {
+
+	Range *selection = calloc(self->selectionCount + indexes->count + 1, sizeof(Range));
+	assert(selection);
+
+	size_t count = 0;
+	for (size_t i = 0; i < self->selectionCount; i++) {
+
+		const Range *range = self->selection + i;
+
+		size_t start = insertRowsAtIndexes_shift(indexes, range->location);
+		const size_t end = insertRowsAtIndexes_shift(indexes, range->location + range->length - 1) + 1;
+
+		size_t j = searchIndexes(indexes->indexes, indexes->count, start);
+		for (; j < indexes->count && indexes->indexes[j] < end; j++) {
+
+			const size_t index = indexes->indexes[j];
+			if (index > start) {
+				selection[count++] = (Range) { .location = start, .length = index - start };
+			}
+
+			start = index + 1;
+		}
+
+		if (end > start) {
+			selection[count++] = (Range) { .location = start, .length = end - start };
+		}
+	}
+
+	free(self->selection);
+
+	self->selection = selection;
+	self->selectionCount = count;
+}
 
 /**
- * @brief Comparator for sorting TableViewRows.
- * @remarks This function relies on thread-local-storage.
+ * @brief Inserts the heights of the rows at the given indexes, requesting them from the delegate.
+ */
+static void insertRowsAtIndexes_heights(TableView *self, const IndexSet *indexes) {
+
+	if (self->rowHeights) {
+
+		int *heights = calloc(self->numberOfRows + 1, sizeof(int));
+		assert(heights);
+
+		for (size_t i = 0, j = 0, k = 0; i < self->numberOfRows; i++) {
+			if (j < indexes->count && indexes->indexes[j] == i) {
+				heights[i] = self->delegate.heightForRow(self, i);
+				j++;
+			} else {
+				heights[i] = self->rowHeights[k++];
+			}
+		}
+
+		free(self->rowHeights);
+		self->rowHeights = heights;
+	}
+}
+
+/**
+ * @fn void TableView::insertRowsAtIndexes(TableView *self, const IndexSet *indexes)
+ * @memberof TableView
  */
-static Order reloadData_sortRows(const ident a, const ident b) {
+static void insertRowsAtIndexes(TableView *self, const IndexSet *indexes) {
+
+	if (indexes && indexes->count) {
+
+		cancelPrefetching(self);
+
+		self->numberOfRows += indexes->count;
+
+		insertRowsAtIndexes_heights(self, indexes);
+
+		if (self->rowMapping) {
+
+			for (size_t i = 0; i < self->rowMappingCount; i++) {
+				self->rowMapping[i] = insertRowsAtIndexes_shift(indexes, self->rowMapping[i]);
+			}
+
+			self->rowMapping = realloc(self->rowMapping, (self->rowMappingCount + indexes->count + 1) * sizeof(size_t));
+			assert(self->rowMapping);
+
+			buildRowPositions(self);
+
+			for (size_t i = 0; i < indexes->count; i++) {
+				if (filterRow(self, indexes->indexes[i])) {
+					insertRowMapping(self, indexes->indexes[i]);
+				}
+			}
+		}
 
-	const TableColumn *column = _sortTableView->sortColumn;
-	if (column->comparator) {
-		const Array *rows = (Array *) _sortTableView->rows;
+		insertRowsAtIndexes_selection(self, indexes);
 
-		const size_t row1 = $(rows, indexOfObject, a);
-		const size_t row2 = $(rows, indexOfObject, b);
+		if (self->selectionAnchor > -1) {
+			self->selectionAnchor = insertRowsAtIndexes_shift(indexes, self->selectionAnchor);
+		}
 
-		const ident value1 = _sortTableView->dataSource.valueForColumnAndRow(_sortTableView, column, row1);
-		const ident value2 = _sortTableView->dataSource.valueForColumnAndRow(_sortTableView, column, row2);
+		const Array *rows = (Array *) self->rows;
+		for (size_t i = 0; i < rows->count; i++) {
 
-		switch (column->order) {
-			case OrderAscending:
-				return column->comparator(value1, value2);
-			case OrderSame:
-				return OrderSame;
-			case OrderDescending:
-				return column->comparator(value2, value1);
+			TableRowView *row = $(rows, objectAtIndex, i);
+			if (row->index > -1) {
+				row->index = insertRowsAtIndexes_shift(indexes, row->index);
+			}
 		}
+
+		rowsDidChange(self);
+
+		buildRowHeightTree(self);
+
+		self->control.view.needsLayout = true;
 	}
+}
 
-	return OrderSame;
+/**
+ * @fn void TableView::markRowsReadyAtIndexes(TableView *self, const IndexSet *indexes)
+ * @memberof TableView
+ */
+static void markRowsReadyAtIndexes(TableView *self, const IndexSet *indexes) {
+
+	assert(indexes);
+
+	SDL_LockMutex(self->readyLock);
+
+	$(self->readyRows, addObject, (ident) indexes);
+
+	SDL_UnlockMutex(self->readyLock);
+}
+
+/**
+ * @return The index of the row at `row` after moving the row at `index` to `newIndex`.
+ */
+static size_t moveRowAtIndex_shift(size_t index, size_t newIndex, size_t row) {
+
+	if (row == index) {
+		return newIndex;
+	} else if (index < newIndex && row > index && row <= newIndex) {
+		return row - 1;
+	} else if (newIndex < index && row >= newIndex && row < index) {
+		return row + 1;
+	}
+
+	return row;
 }
 
 /**
- * @brief ArrayEnumerator to add TableRowViews to the table's contentView.
+ * @fn void TableView::moveRowAtIndex(TableView *self, size_t index, size_t newIndex)
+ * @memberof TableView
  */
-static void reloadData_addRows(const Array *array, ident obj, ident data) {
-	$((View *) data, addSubview, (View *) obj);
+static void moveRowAtIndex(TableView *self, size_t index, size_t newIndex) {
+
+	if (index < self->numberOfRows && newIndex < self->numberOfRows && index != newIndex) {
+
+		cancelPrefetching(self);
+
+		if (self->rowMapping) {
+			for (size_t i = 0; i < self->rowMappingCount; i++) {
+				self->rowMapping[i] = moveRowAtIndex_shift(index, newIndex, self->rowMapping[i]);
+			}
+
+			if (self->sortColumn == NULL || self->sortColumn->comparator == NULL) {
+				qsort(self->rowMapping, self->rowMappingCount, sizeof(size_t), compareIndexes);
+			}
+
+			buildRowPositions(self);
+		}
+
+		if (self->rowHeights) {
+			const int height = self->rowHeights[index];
+
+			if (index < newIndex) {
+				memmove(self->rowHeights + index, self->rowHeights + index + 1, (newIndex - index) * sizeof(int));
+			} else {
+				memmove(self->rowHeights + newIndex + 1, self->rowHeights + newIndex, (index - newIndex) * sizeof(int));
+			}
+
+			self->rowHeights[newIndex] = height;
+		}
+
+		const _Bool isSelected = isRowSelected(self, index);
+
+		IndexSet *deleted = $(alloc(IndexSet), initWithIndex, index);
+		deleteRowsAtIndexes_selection(self, deleted);
+		release(deleted);
+
+		IndexSet *inserted = $(alloc(IndexSet), initWithIndex, newIndex);
+		insertRowsAtIndexes_selection(self, inserted);
+		release(inserted);
+
+		if (isSelected) {
+			setRowsSelected(self, newIndex, newIndex + 1, true);
+		}
+
+		if (self->selectionAnchor > -1) {
+			self->selectionAnchor = moveRowAtIndex_shift(index, newIndex, self->selectionAnchor);
+		}
+
+		const Array *rows = (Array *) self->rows;
+		for (size_t i = 0; i < rows->count; i++) {
+
+			TableRowView *row = $(rows, objectAtIndex, i);
+			if (row->index > -1) {
+				row->index = moveRowAtIndex_shift(index, newIndex, row->index);
+			}
+		}
+
+		rowsDidChange(self);
+
+		buildRowHeightTree(self);
+
+		self->control.view.needsLayout = true;
+	}
 }
 
 /**
@@ -439,54 +2611,109 @@ static void reloadData(TableView *self) {
 	assert(self->dataSource.numberOfRows);
 	assert(self->delegate.cellForColumnAndRow);
 
-	$((Array *) self->rows, enumerateObjects, reloadData_removeRows, self->contentView);
-	$(self->rows, removeAllObjects);
+	cancelPrefetching(self);
 
-	TableRowView *headerView = (TableRowView *) self->headerView;
-	$(headerView, removeAllCells);
+	invalidateColumns(self);
+	invalidateValues(self);
 
-	const Array *columns = (Array *) self->columns;
-	for (size_t i = 0; i < columns->count; i++) {
+	self->numberOfRows = self->dataSource.numberOfRows(self);
 
-		const TableColumn *column = $(columns, objectAtIndex, i);
-		$(headerView, addCell, (TableCellView *) column->headerCell);
-	}
+	reloadRowHeights(self);
 
-	const size_t numberOfRows = self->dataSource.numberOfRows(self);
-	for (size_t i = 0; i < numberOfRows; i++) {
+	TableViewFilter *filter = self->filter;
+	if (filter->query) {
 
-		TableRowView *row = $(alloc(TableRowView), initWithTableView, self);
-		assert(row);
+		if (self->rowMapping) {
+			size_t count = 0;
+			for (size_t i = 0; i < self->rowMappingCount; i++) {
+				if (self->rowMapping[i] < self->numberOfRows) {
+					self->rowMapping[count++] = self->rowMapping[i];
+				}
+			}
+			self->rowMappingCount = count;
+
+			buildRowPositions(self);
+		}
 
-		$(self->rows, addObject, row);
-		release(row);
+		filter->generation++;
+		submitFilter(self, false);
+	} else {
+		sortRows(self);
+	}
 
-		for (size_t j = 0; j < columns->count; j++) {
-			const TableColumn *column = $(columns, objectAtIndex, j);
+	buildRowHeightTree(self);
 
-			TableCellView *cell = self->delegate.cellForColumnAndRow(self, column, i);
-			assert(cell);
+	setRowsSelected(self, self->numberOfRows, SIZE_MAX, false);
 
-			$(row, addCell, cell);
-			release(cell);
-		}
+	if (self->selectionAnchor >= (ssize_t) self->numberOfRows) {
+		self->selectionAnchor = -1;
 	}
 
-	if (self->sortColumn) {
-		_sortTableView = self;
+	invalidateRows(self);
+}
+
+/**
+ * @fn void TableView::reloadRowsAtIndexes(TableView *self, const IndexSet *indexes)
+ * @memberof TableView
+ */
+static void reloadRowsAtIndexes(TableView *self, const IndexSet *indexes) {
 
-		MutableArray *rows = (MutableArray *) $((Object *) self->rows, copy);
-		$(rows, sort, reloadData_sortRows);
+	assert(self->delegate.cellForColumnAndRow);
 
-		release(self->rows);
-		self->rows = rows;
+	if (indexes && indexes->count) {
 
-		_sortTableView = NULL;
-	}
+		_Bool didChangeMapping = false;
 
-	$((Array *) self->rows, enumerateObjects, reloadData_addRows, self->contentView);
+		for (size_t i = 0; i < indexes->count; i++) {
+			const size_t index = indexes->indexes[i];
 
-	self->control.view.needsLayout = true;
+			if (index >= self->numberOfRows) {
+				continue;
+			}
+
+			int delta = 0;
+			if (self->rowHeights) {
+				const int height = self->delegate.heightForRow(self, index);
+				delta = height - self->rowHeights[index];
+
+				self->rowHeights[index] = height;
+			}
+
+			if (self->rowMapping && isRowMappingValid(self, index) == false) {
+
+				if (didChangeMapping == false) {
+					cancelPrefetching(self);
+					didChangeMapping = true;
+				}
+
+				const _Bool isPresented = removeRowMapping(self, index);
+
+				if (filterRow(self, index)) {
+					if (isPresented == false) {
+						self->rowMapping = realloc(self->rowMapping, (self->rowMappingCount + 2) * sizeof(size_t));
+						assert(self->rowMapping);
+					}
+					insertRowMapping(self, index);
+				}
+			} else if (delta && didChangeMapping == false) {
+
+				const ssize_t position = positionOfRow(self, index);
+				if (position > -1) {
+					updateRowHeightTree(self, position, delta);
+				}
+			}
+		}
+
+		if (didChangeMapping) {
+			buildRowHeightTree(self);
+		}
+
+		rowsDidChange(self);
+
+		repopulateRows(self, indexes);
+
+		self->control.view.needsLayout = true;
+	}
 }
 
 /**
@@ -501,7 +2728,42 @@ static void removeColumn(TableView *self, TableColumn *column) {
 		self->sortColumn = NULL;
 	}
 
+	if (self->resizingColumn == column) {
+		self->resizingColumn = NULL;
+	}
+
 	$(self->columns, removeObject, column);
+
+	invalidateColumns(self);
+	invalidateValues(self);
+	invalidateRows(self);
+}
+
+/**
+ * @fn void TableView::resizeColumn(TableView *self, TableColumn *column, int width)
+ * @memberof TableView
+ */
+static void resizeColumn(TableView *self, TableColumn *column, int width) {
+
+	assert(column);
+
+	if (column->minWidth) {
+		width = max(width, column->minWidth);
+	}
+
+	if (column->maxWidth) {
+		width = min(width, column->maxWidth);
+	}
+
+	width = max(width, 1);
+
+	if (width != column->width) {
+		column->width = width;
+
+		invalidateColumnOffsets(self);
+
+		self->control.view.needsLayout = true;
+	}
 }
 
 /**
@@ -510,10 +2772,12 @@ static void removeColumn(TableView *self, TableColumn *column) {
  */
 static ssize_t rowAtPoint(const TableView *self, const SDL_Point *point) {
 
-	if (self->rowHeight) {
-		const SDL_Rect contentFrame = $((View *) self->contentView, renderFrame);
-		if (SDL_PointInRect(point, &contentFrame)) {
-			return (point->y - contentFrame.y) / self->rowHeight;
+	const SDL_Rect contentFrame = $(self->contentView, renderFrame);
+	if (SDL_PointInRect(point, &contentFrame)) {
+
+		const size_t position = positionAtOffset(self, point->y - contentFrame.y);
+		if (position < numberOfPresentedRows(self)) {
+			return rowAtPosition(self, position);
 		}
 	}
 
@@ -538,19 +2802,17 @@ static SDL_Rect scrollableArea(const TableView *self) {
 	return frame;
 }
 
-/**
- * @brief ArrayEnumerator for all row selection.
- */
-static void selectAll_enumerate(const Array *array, ident obj, ident data) {
-	$((TableRowView *) obj, setSelected, true);
-}
-
 /**
  * @fn void TableView::selectAll(TableView *self)
  * @memberof TableView
  */
 static void selectAll(TableView *self) {
-	$((Array *) self->rows, enumerateObjects, selectAll_enumerate, NULL);
+
+	self->selectionCount = 0;
+
+	selectPositions(self, 0, numberOfPresentedRows(self));
+
+	self->control.view.needsLayout = true;
 }
 
 /**
@@ -559,19 +2821,27 @@ static void selectAll(TableView *self) {
  */
 static IndexSet *selectedRowIndexes(const TableView *self) {
 
-	size_t indexes[self->rows->array.count];
 	size_t count = 0;
+	for (size_t i = 0; i < self->selectionCount; i++) {
+		count += self->selection[i].length;
+	}
 
-	const Array *rows = (Array *) self->rows;
-	for (size_t i = 0; i < rows->count; i++) {
+	size_t *indexes = calloc(count + 1, sizeof(size_t));
+	assert(indexes);
 
-		const TableRowView *row = $(rows, objectAtIndex, i);
-		if (row->isSelected) {
-			indexes[count++] = i;
+	size_t *index = indexes;
+	for (size_t i = 0; i < self->selectionCount; i++) {
+
+		const Range *range = self->selection + i;
+		for (size_t j = 0; j < range->length; j++) {
+			*index++ = range->location + j;
 		}
 	}
 
-	return $(alloc(IndexSet), initWithIndexes, indexes, count);
+	IndexSet *selectedRowIndexes = $(alloc(IndexSet), initWithIndexes, indexes, count);
+
+	free(indexes);
+	return selectedRowIndexes;
 }
 
 /**
@@ -580,11 +2850,10 @@ static IndexSet *selectedRowIndexes(const TableView *self) {
  */
 static void selectRowAtIndex(TableView *self, size_t index) {
 
-	const Array *rows = (Array *) self->rows;
-	if (index < rows->count) {
+	if (index < self->numberOfRows) {
+		setRowsSelected(self, index, index + 1, true);
 
-		TableRowView *row = $(rows, objectAtIndex, index);
-		$(row, setSelected, true);
+		self->control.view.needsLayout = true;
 	}
 }
 
@@ -595,12 +2864,33 @@ static void selectRowAtIndex(TableView *self, size_t index) {
 static void selectRowsAtIndexes(TableView *self, const IndexSet *indexes) {
 
 	if (indexes) {
-		for (size_t i = 0; i < indexes->count; i++) {
-			$(self, selectRowAtIndex, indexes->indexes[i]);
+		for (size_t i = 0; i < indexes->count; ) {
+
+			size_t j = i + 1;
+			while (j < indexes->count && indexes->indexes[j] == indexes->indexes[j - 1] + 1) {
+				j++;
+			}
+
+			$(self, selectRowsInRange, (Range) { .location = indexes->indexes[i], .length = j - i });
+			i = j;
 		}
 	}
 }
 
+/**
+ * @fn void TableView::selectRowsInRange(TableView *self, const Range range)
+ * @memberof TableView
+ */
+static void selectRowsInRange(TableView *self, const Range range) {
+
+	const size_t start = max(range.location, 0);
+	const size_t end = min((size_t) range.location + range.length, self->numberOfRows);
+
+	setRowsSelected(self, start, end, true);
+
+	self->control.view.needsLayout = true;
+}
+
 /**
  * @fn void TableView::setSortColumn(TableView *self, TableColumn *column)
  * @memberof TableView
@@ -641,24 +2931,33 @@ static void initialize(Class *clazz) {
 	((ViewInterface *) clazz->def->interface)->init = init;
 	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
 	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
+	((ViewInterface *) clazz->def->interface)->willLayoutSubviews = willLayoutSubviews;
 
 	((ControlInterface *) clazz->def->interface)->captureEvent = captureEvent;
 
 	((TableViewInterface *) clazz->def->interface)->addColumn = addColumn;
 	((TableViewInterface *) clazz->def->interface)->columnAtPoint = columnAtPoint;
 	((TableViewInterface *) clazz->def->interface)->columnWithIdentifier = columnWithIdentifier;
+	((TableViewInterface *) clazz->def->interface)->deleteRowsAtIndexes = deleteRowsAtIndexes;
 	((TableViewInterface *) clazz->def->interface)->deselectAll = deselectAll;
 	((TableViewInterface *) clazz->def->interface)->deselectRowAtIndex = deselectRowAtIndex;
 	((TableViewInterface *) clazz->def->interface)->deselectRowsAtIndexes = deselectRowsAtIndexes;
+	((TableViewInterface *) clazz->def->interface)->filterRows = filterRows;
 	((TableViewInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
+	((TableViewInterface *) clazz->def->interface)->insertRowsAtIndexes = insertRowsAtIndexes;
+	((TableViewInterface *) clazz->def->interface)->markRowsReadyAtIndexes = markRowsReadyAtIndexes;
+	((TableViewInterface *) clazz->def->interface)->moveRowAtIndex = moveRowAtIndex;
 	((TableViewInterface *) clazz->def->interface)->reloadData = reloadData;
+	((TableViewInterface *) clazz->def->interface)->reloadRowsAtIndexes = reloadRowsAtIndexes;
 	((TableViewInterface *) clazz->def->interface)->removeColumn = removeColumn;
+	((TableViewInterface *) clazz->def->interface)->resizeColumn = resizeColumn;
 	((TableViewInterface *) clazz->def->interface)->rowAtPoint = rowAtPoint;
 	((TableViewInterface *) clazz->def->interface)->scrollableArea = scrollableArea;
 	((TableViewInterface *) clazz->def->interface)->selectedRowIndexes = selectedRowIndexes;
 	((TableViewInterface *) clazz->def->interface)->selectAll = selectAll;
 	((TableViewInterface *) clazz->def->interface)->selectRowAtIndex = selectRowAtIndex;
 	((TableViewInterface *) clazz->def->interface)->selectRowsAtIndexes = selectRowsAtIndexes;
+	((TableViewInterface *) clazz->def->interface)->selectRowsInRange = selectRowsInRange;
 	((TableViewInterface *) clazz->def->interface)->setSortColumn = setSortColumn;
 }
 
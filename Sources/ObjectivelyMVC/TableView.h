@@ -41,6 +41,8 @@
 
 typedef struct TableViewDataSource TableViewDataSource;
 typedef struct TableViewDelegate TableViewDelegate;
+typedef struct TableViewFilter TableViewFilter;
+typedef struct TableViewRowRun TableViewRowRun;
 
 typedef struct TableViewInterface TableViewInterface;
 
@@ -54,6 +56,16 @@ struct TableViewDataSource {
 	 */
 	ident self;
 
+	/**
+	 * @brief Called by the TableView to determine if a row's data is available.
+	 * @param tableView The TableView.
+	 * @param row The row number.
+	 * @return True if the row's data is available, false otherwise.
+	 * @remarks This function is optional. Rows that are not ready are presented with placeholder
+	 * cells until TableView::markRowsReadyAtIndexes is called for them.
+	 */
+	_Bool (*isRowReady)(const TableView *tableView, size_t row);
+
 	/**
 	 * @param tableView The TableView.
 	 * @return The number of rows in the TableView.
@@ -68,6 +80,17 @@ struct TableViewDataSource {
 	 * @return The value for the cell at the given column and row number.
 	 */
 	ident (*valueForColumnAndRow)(const TableView *tableView, const TableColumn *column, size_t row);
+
+	/**
+	 * @brief Called by the TableView for the associated values of a column over a range of rows.
+	 * @param tableView The TableView.
+	 * @param column The column.
+	 * @param range The range of row numbers.
+	 * @param values The buffer to fill, with capacity for `range.length` values.
+	 * @remarks This function is optional. When implemented, it is preferred over
+	 * `valueForColumnAndRow` for sorting, allowing columnar models to copy values in bulk.
+	 */
+	void (*valuesForColumnInRange)(const TableView *tableView, const TableColumn *column, const Range range, ident *values);
 };
 
 /**
@@ -80,12 +103,21 @@ struct TableViewDelegate {
 	 */
 	ident self;
 
+	/**
+	 * @brief Called by the TableView when rows leave the prefetch range before becoming visible.
+	 * @param tableView The TableView.
+	 * @param indexes The indexes of the rows for which prefetching may be cancelled.
+	 * @remarks This function is optional.
+	 */
+	void (*cancelPrefetchingForRowsAtIndexes)(TableView *tableView, const IndexSet *indexes);
+
 	/**
 	 * @brief Called by the TableView to instantiate cells.
 	 * @param tableView The TableView.
 	 * @param column The TableColumn.
 	 * @param row The row number.
 	 * @return The cell for the given column and row number.
+	 * @remarks This function is not called for columns with a TableColumnFormatter.
 	 */
 	TableCellView *(*cellForColumnAndRow)(const TableView *tableView, const TableColumn *column, size_t row);
 
@@ -96,11 +128,35 @@ struct TableViewDelegate {
 	 * @remarks This function is optional.
 	 */
 	void (*didSelectRowsAtIndexes)(TableView *tableView, const IndexSet *selectedRowIndexes);
+
+	/**
+	 * @brief Called by the TableView to determine the height of a row.
+	 * @param tableView The TableView.
+	 * @param row The row number.
+	 * @return The height of the given row.
+	 * @remarks This function is optional. If not implemented, all rows are `rowHeight` tall. Row
+	 * heights are requested when rows are reloaded or inserted, and cached until then.
+	 */
+	int (*heightForRow)(const TableView *tableView, size_t row);
+
+	/**
+	 * @brief Called by the TableView when rows enter the prefetch range, ahead of becoming visible.
+	 * @param tableView The TableView.
+	 * @param indexes The indexes of the rows to prefetch.
+	 * @remarks This function is optional. Implementations should begin loading the rows
+	 * asynchronously, and call TableView::markRowsReadyAtIndexes when they are available. The
+	 * prefetch range is reset when the table's rows are reloaded, inserted or deleted, so rows may
+	 * be requested more than once.
+	 */
+	void (*prefetchRowsAtIndexes)(TableView *tableView, const IndexSet *indexes);
 };
 
 #define DEFAULT_TABLE_VIEW_PADDING 4
 #define DEFAULT_TABLE_VIEW_CELL_SPACING 2
 #define DEFAULT_TABLE_VIEW_ROW_HEIGHT 24
+#define DEFAULT_TABLE_VIEW_PREFETCH_DISTANCE 32
+
+#define TABLE_VIEW_COLUMN_RESIZE_MARGIN 4
 
 /**
  * @brief TableViews provide sortable, tabular presentations of data.
@@ -127,18 +183,42 @@ struct TableView {
 
 	/**
 	 * @brief Inter-cell (horizontal) spacing.
+	 * @remarks Changes made after the TableView is laid out take effect at the next reload.
+	 * @see TableView::reloadData(TableView *)
 	 */
 	int cellSpacing;
 
+	/**
+	 * @brief The x offsets of the columns, followed by the total width of the columns, shared by
+	 * all rows.
+	 * @private
+	 */
+	int *columnOffsets;
+
+	/**
+	 * @brief The width of the table for which `columnOffsets` were computed.
+	 * @private
+	 */
+	int columnOffsetsWidth;
+
 	/**
 	 * @brief The column definitions.
 	 */
 	MutableArray *columns;
 
+	/**
+	 * @brief If true, rows set `concurrentLayout`, and are laid out on the LayoutQueue, if any.
+	 * @remarks Enable this only if the layout of every cell is safe to run off the main thread.
+	 * Cells must not make OpenGL calls during layout, e.g. by calling Text::setText or
+	 * ImageView::setImage, which delete textures.
+	 * @see View::setLayoutQueue(LayoutQueue *)
+	 */
+	_Bool concurrentRowLayout;
+
 	/**
 	 * @brief The content View.
 	 */
-	StackView *contentView;
+	View *contentView;
 
 	/**
 	 * @brief The data source.
@@ -150,26 +230,155 @@ struct TableView {
 	 */
 	TableViewDelegate delegate;
 
+	/**
+	 * @brief The background filter-and-sort pipeline.
+	 * @private
+	 */
+	TableViewFilter *filter;
+
 	/**
 	 * @brief The header.
 	 */
 	TableHeaderView *headerView;
 
 	/**
-	 * @brief The rows.
+	 * @brief The number of rows, as reported by the data source.
 	 */
-	MutableArray *rows;
+	size_t numberOfRows;
+
+	/**
+	 * @brief The number of rows beyond the visible range to prefetch.
+	 */
+	int prefetchDistance;
+
+	/**
+	 * @brief The range of row positions most recently prefetched.
+	 * @private
+	 */
+	Range prefetchRange;
+
+	/**
+	 * @brief The lock guarding `readyRows`.
+	 * @private
+	 */
+	SDL_mutex *readyLock;
+
+	/**
+	 * @brief The IndexSets of rows marked ready, pending reload on the main thread.
+	 * @private
+	 */
+	MutableArray *readyRows;
+
+	/**
+	 * @brief The column being resized by the user, or `NULL`.
+	 * @private
+	 */
+	TableColumn *resizingColumn;
+
+	/**
+	 * @brief The x coordinate of the mouse, and the width of `resizingColumn`, when resizing began.
+	 * @private
+	 */
+	int resizingOrigin, resizingWidth;
+
+	/**
+	 * @brief Recycled TableRowViews, available for reuse.
+	 * @private
+	 */
+	MutableArray *reusableRows;
 
 	/**
-	 * @brief The row height.
+	 * @brief The row height, used when the delegate does not provide row heights.
 	 */
 	int rowHeight;
 
+	/**
+	 * @brief A Fenwick tree of the heights of the presented rows, in presentation order, or `NULL`
+	 * when all rows are `rowHeight` tall.
+	 * @remarks This allows the offset of a row, and the row at an offset, to be found in
+	 * logarithmic time.
+	 * @private
+	 */
+	int *rowHeightTree;
+
+	/**
+	 * @brief The count of rows in `rowHeightTree`.
+	 * @private
+	 */
+	size_t rowHeightTreeCount;
+
+	/**
+	 * @brief The heights of the rows, by data source index, or `NULL` when all rows are
+	 * `rowHeight` tall.
+	 * @private
+	 */
+	int *rowHeights;
+
+	/**
+	 * @brief The data source indexes of the presented rows, in presentation order, or `NULL` when
+	 * all rows are presented in data source order.
+	 * @private
+	 */
+	size_t *rowMapping;
+
+	/**
+	 * @brief The count of `rowMapping`.
+	 * @private
+	 */
+	size_t rowMappingCount;
+
+	/**
+	 * @brief The presentation positions of the rows, by data source index, or `-1` for rows that
+	 * are not presented. Maintained alongside `rowMapping`, and `NULL` when it is.
+	 * @private
+	 */
+	ssize_t *rowPositions;
+
+	/**
+	 * @brief The runs of consecutive data source indexes in `rowMapping`, or `NULL` until they are
+	 * needed. Discarded whenever `rowMapping` changes.
+	 * @private
+	 */
+	TableViewRowRun *rowRuns;
+
+	/**
+	 * @brief The count of `rowRuns`.
+	 * @private
+	 */
+	size_t rowRunsCount;
+
+	/**
+	 * @brief The visible rows.
+	 * @remarks Only the rows within the visible range are instantiated. Rows scrolled out of view
+	 * are recycled.
+	 */
+	MutableArray *rows;
+
 	/**
 	 * @brief The scroll view.
 	 */
 	ScrollView *scrollView;
 
+	/**
+	 * @brief The selected rows, as sorted, disjoint and non-adjacent ranges of indexes.
+	 * @remarks The selection is independent of the row views, and is preserved as rows are
+	 * recycled, inserted, deleted and moved.
+	 * @private
+	 */
+	Range *selection;
+
+	/**
+	 * @brief The count of ranges in `selection`.
+	 * @private
+	 */
+	size_t selectionCount;
+
+	/**
+	 * @brief The index of the row from which Shift-selection extends, or `-1`.
+	 * @private
+	 */
+	ssize_t selectionAnchor;
+
 	/**
 	 * @brief The column to sort by.
 	 */
@@ -179,6 +388,16 @@ struct TableView {
 	 * @brief Set to `true` to enable alternate row coloring.
 	 */
 	_Bool usesAlternateBackgroundColor;
+
+	/**
+	 * @brief The range of visible column indexes.
+	 */
+	Range visibleColumnRange;
+
+	/**
+	 * @brief The range of visible row positions.
+	 */
+	Range visibleRange;
 };
 
 /**
@@ -218,6 +437,17 @@ struct TableViewInterface {
 	 */
 	TableColumn *(*columnWithIdentifier)(const TableView *self, const char *identifier);
 
+	/**
+	 * @fn void TableView::deleteRowsAtIndexes(TableView *self, const IndexSet *indexes)
+	 * @brief Deletes the rows at the given indexes.
+	 * @param self The TableView.
+	 * @param indexes The indexes of the rows to delete, relative to the data source prior to deletion.
+	 * @remarks The data source must have removed the corresponding rows before this method is called.
+	 * The selection and scroll position of the remaining rows are preserved.
+	 * @memberof TableView
+	 */
+	void (*deleteRowsAtIndexes)(TableView *self, const IndexSet *indexes);
+
 	/**
 	 * @fn void TableView::deselectAll(TableView *self)
 	 * @brief Deselects all rows in this TableView.
@@ -244,6 +474,24 @@ struct TableViewInterface {
 	 */
 	void (*deselectRowsAtIndexes)(TableView *self, const IndexSet *indexSet);
 
+	/**
+	 * @fn void TableView::filterRows(TableView *self, TableColumn *column, Predicate predicate, const char *query)
+	 * @brief Filters the presented rows to those whose values satisfy the given Predicate.
+	 * @param self The TableView.
+	 * @param column The column whose values are filtered, or `NULL` to match any column.
+	 * @param predicate The Predicate, which receives each value and `query`.
+	 * @param query The query (e.g. a search string), or `NULL` to remove the filter.
+	 * @remarks Filtering and sorting of the filtered rows are performed on a background thread over
+	 * values gathered from the data source, so the predicate and the sort column's comparator must
+	 * be thread-safe. Each column's values are gathered once, and reused by later queries until the
+	 * rows or the columns change, so they must remain valid until then. A filter in progress is
+	 * cancelled when a new query is given. The presented rows are replaced when the filter completes.
+	 * If `query` extends the previous query, only the previously matched rows are filtered again, so
+	 * the predicate should match no new rows as the query grows longer, as a substring search does.
+	 * @memberof TableView
+	 */
+	void (*filterRows)(TableView *self, TableColumn *column, Predicate predicate, const char *query);
+
 	/**
 	 * @fn TableView *TableView::initWithFrame(TableView *self, const SDL_Rect *frame, ControlStyle style)
 	 * @brief Initializes this TableView with the specified frame and style.
@@ -255,6 +503,41 @@ struct TableViewInterface {
 	 */
 	TableView *(*initWithFrame)(TableView *self, const SDL_Rect *frame, ControlStyle style);
 
+	/**
+	 * @fn void TableView::insertRowsAtIndexes(TableView *self, const IndexSet *indexes)
+	 * @brief Inserts rows at the given indexes.
+	 * @param self The TableView.
+	 * @param indexes The indexes of the inserted rows, relative to the data source after insertion.
+	 * @remarks The data source must have inserted the corresponding rows before this method is called.
+	 * Only inserted rows that become visible are instantiated; existing rows, the selection and the
+	 * scroll position are preserved. If a sort column is set, the inserted rows are presented in
+	 * sorted order.
+	 * @memberof TableView
+	 */
+	void (*insertRowsAtIndexes)(TableView *self, const IndexSet *indexes);
+
+	/**
+	 * @fn void TableView::markRowsReadyAtIndexes(TableView *self, const IndexSet *indexes)
+	 * @brief Marks the rows at the given indexes as ready, replacing their placeholder cells.
+	 * @param self The TableView.
+	 * @param indexes The indexes of the rows whose data is now available.
+	 * @remarks This method is thread-safe, and may be called from the thread that loaded the rows.
+	 * The rows are reloaded on the main thread during the next layout pass.
+	 * @memberof TableView
+	 */
+	void (*markRowsReadyAtIndexes)(TableView *self, const IndexSet *indexes);
+
+	/**
+	 * @fn void TableView::moveRowAtIndex(TableView *self, size_t index, size_t newIndex)
+	 * @brief Moves the row at `index` to `newIndex`.
+	 * @param self The TableView.
+	 * @param index The index of the row prior to the move.
+	 * @param newIndex The index of the row after the move.
+	 * @remarks The data source must have moved the corresponding row before this method is called.
+	 * @memberof TableView
+	 */
+	void (*moveRowAtIndex)(TableView *self, size_t index, size_t newIndex);
+
 	/**
 	 * @fn void TableView::reloadData(TableView *self)
 	 * @brief Reloads this TableView's visible rows.
@@ -265,6 +548,18 @@ struct TableViewInterface {
 	 */
 	void (*reloadData)(TableView *self);
 
+	/**
+	 * @fn void TableView::reloadRowsAtIndexes(TableView *self, const IndexSet *indexes)
+	 * @brief Reloads the cells of the rows at the given indexes.
+	 * @param self The TableView.
+	 * @param indexes The indexes of the rows to reload.
+	 * @remarks Only the cells of the given rows that are visible are recreated. If a sort column is
+	 * set, the rows are repositioned according to their new values. If the delegate provides row
+	 * heights, the heights of the given rows are requested again.
+	 * @memberof TableView
+	 */
+	void (*reloadRowsAtIndexes)(TableView *self, const IndexSet *indexes);
+
 	/**
 	 * @fn void TableView::removeColumn(TableView *self, TableColumn *column)
 	 * @brief Removes the specified column from this table.
@@ -274,11 +569,24 @@ struct TableViewInterface {
 	 */
 	void (*removeColumn)(TableView *self, TableColumn *column);
 
+	/**
+	 * @fn void TableView::resizeColumn(TableView *self, TableColumn *column, int width)
+	 * @brief Resizes the given column, within its minimum and maximum widths.
+	 * @param self The TableView.
+	 * @param column The column.
+	 * @param width The desired width.
+	 * @remarks The column geometry is shared by all rows, so only the visible rows are laid out
+	 * again, and cell content is not measured. Users may also resize columns by dragging the right
+	 * edges of their header cells.
+	 * @memberof TableView
+	 */
+	void (*resizeColumn)(TableView *self, TableColumn *column, int width);
+
 	/**
 	 * @fn int TableView::rowAtPoint(const TableView *self, const SDL_Point *point)
 	 * @param self The TableView.
 	 * @param point A point in window coordinate space.
-	 * @return The row index at the specified point, or `-1` if none.
+	 * @return The data source index of the row at the specified point, or `-1` if none.
 	 * @memberof TableView
 	 */
 	ssize_t (*rowAtPoint)(const TableView *self, const SDL_Point *point);
@@ -325,6 +633,16 @@ struct TableViewInterface {
 	 */
 	void (*selectRowsAtIndexes)(TableView *self, const IndexSet *indexes);
 
+	/**
+	 * @fn void TableView::selectRowsInRange(TableView *self, const Range range)
+	 * @brief Selects the rows at the indexes in the given range.
+	 * @param self The TableView.
+	 * @param range The range of row indexes to select.
+	 * @remarks The selection is stored as ranges, so selecting contiguous rows is inexpensive.
+	 * @memberof TableView
+	 */
+	void (*selectRowsInRange)(TableView *self, const Range range);
+
 	/**
 	 * @fn void TableView::setSortColumn(TableView *self, TableColumn *column)
 	 * @brief Sets the sort column for this table.
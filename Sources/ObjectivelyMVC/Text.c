@@ -27,6 +27,18 @@
 
 #define _Class _Text
 
+/**
+ * @brief Discards the natural size of the given Text, so that it is measured again.
+ */
+static void invalidateNaturalSize(Text *self) {
+
+	SDL_AtomicLock(&self->naturalSizeLock);
+
+	self->naturalSize = MakeSize(-1, -1);
+
+	SDL_AtomicUnlock(&self->naturalSizeLock);
+}
+
 #pragma mark - ObjectInterface
 
 /**
@@ -110,6 +122,8 @@ static void renderDeviceDidReset(View *self) {
 
 	this->texture = 0;
 
+	invalidateNaturalSize(this);
+
 	$(this->font, renderDeviceDidReset);
 }
 
@@ -133,6 +147,7 @@ static Text *initWithText(Text *self, const char *text, Font *font) {
 	if (self) {
 
 		self->color = Colors.White;
+		self->naturalSize = MakeSize(-1, -1);
 
 		$(self, setFont, font);
 		$(self, setText, text);
@@ -147,12 +162,25 @@ static Text *initWithText(Text *self, const char *text, Font *font) {
  */
 static SDL_Size naturalSize(const Text *self) {
 
-	SDL_Size size = MakeSize(0, 0);
+	Text *this = (Text *) self;
+
+	SDL_AtomicLock(&this->naturalSizeLock);
+
+	if (this->naturalSize.w == -1) {
+
+		SDL_Size size = MakeSize(0, 0);
+
+		if (this->font && this->text) {
+			$(this->font, sizeCharacters, this->text, &size.w, &size.h);
+		}
 
-	if (self->font && self->text) {
-		$(self->font, sizeCharacters, self->text, &size.w, &size.h);
+		this->naturalSize = size;
 	}
 
+	const SDL_Size size = this->naturalSize;
+
+	SDL_AtomicUnlock(&this->naturalSizeLock);
+
 	return size;
 }
 
@@ -169,6 +197,8 @@ static void setFont(Text *self, Font *font) {
 		release(self->font);
 		self->font = retain(font);
 
+		invalidateNaturalSize(self);
+
 		if (self->texture) {
 			glDeleteTextures(1, &self->texture);
 			self->texture = 0;
@@ -192,6 +222,8 @@ static void setText(Text *self, const char *text) {
 		self->text = NULL;
 	}
 
+	invalidateNaturalSize(self);
+
 	if (self->texture) {
 		glDeleteTextures(1, &self->texture);
 		self->texture = 0;
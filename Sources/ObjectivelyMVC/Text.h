@@ -63,6 +63,18 @@ struct Text {
 	 */
 	Font *font;
 
+	/**
+	 * @brief The natural size, or `-1` by `-1` if it must be measured.
+	 * @private
+	 */
+	SDL_Size naturalSize;
+
+	/**
+	 * @brief The lock guarding `naturalSize`, which LayoutQueue threads may resolve.
+	 * @private
+	 */
+	SDL_SpinLock naturalSizeLock;
+
 	/**
 	 * @brief The text.
 	 * @remarks Do not set this property directly.
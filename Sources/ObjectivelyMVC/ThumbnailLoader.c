@@ -0,0 +1,743 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL_image.h>
+
+#include <Objectively/Resource.h>
+
+#include <ObjectivelyMVC/ThumbnailLoader.h>
+
+typedef struct ThumbnailLoaderEntry ThumbnailLoaderEntry;
+typedef struct ThumbnailLoaderJob ThumbnailLoaderJob;
+
+/**
+ * @brief A cached thumbnail.
+ */
+struct ThumbnailLoaderEntry {
+
+	/**
+	 * @brief The image resource name.
+	 */
+	char *name;
+
+	/**
+	 * @brief The thumbnail.
+	 */
+	Image *image;
+
+	/**
+	 * @brief The next entry in the same bucket.
+	 */
+	ThumbnailLoaderEntry *chain;
+
+	/**
+	 * @brief The more and less recently used entries.
+	 */
+	ThumbnailLoaderEntry *newer, *older;
+};
+
+/**
+ * @brief The LRU cache of a ThumbnailLoader, hashed by name.
+ */
+struct ThumbnailLoaderCache {
+
+	/**
+	 * @brief The hash buckets.
+	 */
+	ThumbnailLoaderEntry **buckets;
+
+	/**
+	 * @brief The count of `buckets`.
+	 */
+	size_t numberOfBuckets;
+
+	/**
+	 * @brief The most and least recently used entries.
+	 */
+	ThumbnailLoaderEntry *newest, *oldest;
+
+	/**
+	 * @brief The count of entries.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The maximum count of entries.
+	 */
+	size_t capacity;
+};
+
+/**
+ * @brief A request to load a thumbnail.
+ */
+struct ThumbnailLoaderJob {
+
+	/**
+	 * @brief The image resource name.
+	 */
+	char *name;
+
+	/**
+	 * @brief The item, which is retained until the job is freed.
+	 */
+	CollectionItemView *item;
+
+	/**
+	 * @brief The size that the thumbnail is scaled to fit.
+	 */
+	SDL_Size size;
+
+	/**
+	 * @brief The thumbnail, once loaded.
+	 */
+	SDL_Surface *surface;
+
+	/**
+	 * @brief True if this job was cancelled while running or awaiting delivery.
+	 */
+	_Bool cancelled;
+
+	/**
+	 * @brief The next job in the same list.
+	 */
+	ThumbnailLoaderJob *next;
+};
+
+/**
+ * @brief The worker threads of a ThumbnailLoader, and their jobs.
+ * @remarks All job lists are guarded by `lock`. Pending jobs are processed most recent first, so
+ * that the items most recently scrolled into view load first.
+ */
+struct ThumbnailLoaderQueue {
+
+	/**
+	 * @brief The lock.
+	 */
+	SDL_mutex *lock;
+
+	/**
+	 * @brief The condition signaled when jobs are pending, or when the workers should quit.
+	 */
+	SDL_cond *condition;
+
+	/**
+	 * @brief The worker threads.
+	 */
+	SDL_Thread *threads[MAX_THUMBNAIL_LOADER_THREADS];
+
+	/**
+	 * @brief The count of `threads`.
+	 */
+	int numberOfThreads;
+
+	/**
+	 * @brief Jobs awaiting a worker.
+	 */
+	ThumbnailLoaderJob *pending;
+
+	/**
+	 * @brief Jobs deferred because their items are not visible.
+	 */
+	ThumbnailLoaderJob *parked;
+
+	/**
+	 * @brief Jobs being processed by a worker.
+	 */
+	ThumbnailLoaderJob *running;
+
+	/**
+	 * @brief Jobs awaiting delivery.
+	 */
+	ThumbnailLoaderJob *done;
+
+	/**
+	 * @brief True when the workers should quit.
+	 */
+	_Bool quit;
+};
+
+#define _Class _ThumbnailLoader
+
+/**
+ * @return The hash of the given name.
+ */
+static size_t hashName(const char *name) {
+
+	size_t hash = 5381;
+	while (*name) {
+		hash = hash * 33 + (unsigned char) *name++;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Unlinks the given entry from the LRU list.
+ */
+static void unlinkEntry(ThumbnailLoaderCache *cache, ThumbnailLoaderEntry *entry) {
+
+	if (entry->newer) {
+		entry->newer->older = entry->older;
+	} else {
+		cache->newest = entry->older;
+	}
+
+	if (entry->older) {
+		entry->older->newer = entry->newer;
+	} else {
+		cache->oldest = entry->newer;
+	}
+
+	entry->newer = entry->older = NULL;
+}
+
+/**
+ * @brief Links the given entry as the most recently used.
+ */
+static void linkEntry(ThumbnailLoaderCache *cache, ThumbnailLoaderEntry *entry) {
+
+	entry->older = cache->newest;
+	entry->newer = NULL;
+
+	if (cache->newest) {
+		cache->newest->newer = entry;
+	} else {
+		cache->oldest = entry;
+	}
+
+	cache->newest = entry;
+}
+
+/**
+ * @return The cached entry for the given name, marked as most recently used, or `NULL`.
+ */
+static ThumbnailLoaderEntry *lookupEntry(ThumbnailLoaderCache *cache, const char *name) {
+
+	ThumbnailLoaderEntry *entry = cache->buckets[hashName(name) % cache->numberOfBuckets];
+	while (entry) {
+		if (strcmp(entry->name, name) == 0) {
+			unlinkEntry(cache, entry);
+			linkEntry(cache, entry);
+			return entry;
+		}
+		entry = entry->chain;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Removes and frees the given entry.
+ */
+static void removeEntry(ThumbnailLoaderCache *cache, ThumbnailLoaderEntry *entry) {
+
+	ThumbnailLoaderEntry **e = cache->buckets + hashName(entry->name) % cache->numberOfBuckets;
+	while (*e != entry) {
+		e = &(*e)->chain;
+	}
+
+	*e = entry->chain;
+
+	unlinkEntry(cache, entry);
+
+	release(entry->image);
+	free(entry->name);
+	free(entry);
+
+	cache->count--;
+}
+
+/**
+ * @brief Caches the given image, evicting the least recently used entries beyond capacity.
+ */
+static void insertEntry(ThumbnailLoaderCache *cache, const char *name, Image *image) {
+
+	ThumbnailLoaderEntry *entry = lookupEntry(cache, name);
+	if (entry) {
+		release(entry->image);
+		entry->image = retain(image);
+		return;
+	}
+
+	entry = calloc(1, sizeof(ThumbnailLoaderEntry));
+	assert(entry);
+
+	entry->name = strdup(name);
+	assert(entry->name);
+
+	entry->image = retain(image);
+
+	ThumbnailLoaderEntry **bucket = cache->buckets + hashName(name) % cache->numberOfBuckets;
+
+	entry->chain = *bucket;
+	*bucket = entry;
+
+	linkEntry(cache, entry);
+	cache->count++;
+
+	while (cache->count > cache->capacity) {
+		removeEntry(cache, cache->oldest);
+	}
+}
+
+/**
+ * @brief Frees the given job.
+ */
+static void freeJob(ThumbnailLoaderJob *job) {
+
+	if (job) {
+		release(job->item);
+
+		SDL_FreeSurface(job->surface);
+
+		free(job->name);
+		free(job);
+	}
+}
+
+/**
+ * @brief Frees the given list of jobs.
+ */
+static void freeJobs(ThumbnailLoaderJob *job) {
+
+	while (job) {
+		ThumbnailLoaderJob *next = job->next;
+		freeJob(job);
+		job = next;
+	}
+}
+
+/**
+ * @brief Frees the jobs in the given list for `item`, or all jobs if `item` is `NULL`.
+ */
+static void removeJobs(ThumbnailLoaderJob **list, const CollectionItemView *item) {
+
+	while (*list) {
+		ThumbnailLoaderJob *job = *list;
+		if (item == NULL || job->item == item) {
+			*list = job->next;
+			freeJob(job);
+		} else {
+			list = &job->next;
+		}
+	}
+}
+
+/**
+ * @brief Cancels the jobs in the given list for `item`, or all jobs if `item` is `NULL`.
+ */
+static void cancelJobs(ThumbnailLoaderJob *job, const CollectionItemView *item) {
+
+	for (; job; job = job->next) {
+		if (item == NULL || job->item == item) {
+			job->cancelled = true;
+		}
+	}
+}
+
+/**
+ * @brief Decodes the named image resource, and scales it to fit `size`.
+ * @return The thumbnail, or `NULL` on error.
+ */
+static SDL_Surface *loadThumbnail(const char *name, const SDL_Size *size) {
+
+	Resource *resource = $$(Resource, resourceWithName, name);
+	if (resource == NULL) {
+		return NULL;
+	}
+
+	SDL_Surface *thumbnail = NULL;
+
+	SDL_RWops *ops = SDL_RWFromConstMem(resource->data->bytes, (int) resource->data->length);
+	if (ops) {
+
+		SDL_Surface *surface = IMG_Load_RW(ops, 1);
+		if (surface) {
+
+			float scale = 1.0;
+			if (size->w > 0 && size->h > 0) {
+				scale = min(1.0, min(size->w / (float) surface->w, size->h / (float) surface->h));
+			}
+
+			const int w = max(1, surface->w * scale);
+			const int h = max(1, surface->h * scale);
+
+			thumbnail = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+			if (thumbnail) {
+				SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+
+				if (SDL_BlitScaled(surface, NULL, thumbnail, NULL)) {
+					SDL_FreeSurface(thumbnail);
+					thumbnail = NULL;
+				}
+			}
+
+			SDL_FreeSurface(surface);
+		}
+	}
+
+	release(resource);
+	return thumbnail;
+}
+
+/**
+ * @brief The worker thread, which loads pending jobs until asked to quit.
+ */
+static int workerThread(void *data) {
+
+	ThumbnailLoaderQueue *queue = data;
+
+	SDL_LockMutex(queue->lock);
+
+	while (true) {
+
+		while (queue->pending == NULL && queue->quit == false) {
+			SDL_CondWait(queue->condition, queue->lock);
+		}
+
+		if (queue->quit) {
+			break;
+		}
+
+		ThumbnailLoaderJob *job = queue->pending;
+		queue->pending = job->next;
+
+		job->next = queue->running;
+		queue->running = job;
+
+		SDL_UnlockMutex(queue->lock);
+
+		SDL_Surface *surface = loadThumbnail(job->name, &job->size);
+
+		SDL_LockMutex(queue->lock);
+
+		ThumbnailLoaderJob **j = &queue->running;
+		while (*j != job) {
+			j = &(*j)->next;
+		}
+
+		*j = job->next;
+
+		job->surface = surface;
+
+		job->next = queue->done;
+		queue->done = job;
+	}
+
+	SDL_UnlockMutex(queue->lock);
+
+	return 0;
+}
+
+/**
+ * @return True if the given item is visible within its clipping superviews.
+ */
+static _Bool isItemVisible(const CollectionItemView *item) {
+
+	const View *view = (View *) item;
+
+	if (view->superview == NULL || $(view, isVisible) == false) {
+		return false;
+	}
+
+	const SDL_Rect clippingFrame = $(view, clippingFrame);
+	return clippingFrame.w > 0 && clippingFrame.h > 0;
+}
+
+/**
+ * @brief Moves the jobs in `from` whose item visibility matches `visible` to `to`.
+ * @return The count of jobs moved.
+ */
+static size_t moveJobs(ThumbnailLoaderJob **from, ThumbnailLoaderJob **to, _Bool visible) {
+
+	size_t count = 0;
+
+	while (*from) {
+		ThumbnailLoaderJob *job = *from;
+		if (isItemVisible(job->item) == visible) {
+			*from = job->next;
+
+			job->next = *to;
+			*to = job;
+
+			count++;
+		} else {
+			from = &job->next;
+		}
+	}
+
+	return count;
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	ThumbnailLoader *this = (ThumbnailLoader *) self;
+
+	ThumbnailLoaderQueue *queue = this->queue;
+
+	SDL_LockMutex(queue->lock);
+
+	queue->quit = true;
+
+	SDL_CondBroadcast(queue->condition);
+	SDL_UnlockMutex(queue->lock);
+
+	for (int i = 0; i < queue->numberOfThreads; i++) {
+		SDL_WaitThread(queue->threads[i], NULL);
+	}
+
+	freeJobs(queue->pending);
+	freeJobs(queue->parked);
+	freeJobs(queue->running);
+	freeJobs(queue->done);
+
+	SDL_DestroyCond(queue->condition);
+	SDL_DestroyMutex(queue->lock);
+
+	free(queue);
+
+	ThumbnailLoaderCache *cache = this->cache;
+
+	while (cache->oldest) {
+		removeEntry(cache, cache->oldest);
+	}
+
+	free(cache->buckets);
+	free(cache);
+
+	release(this->placeholder);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - ThumbnailLoader
+
+/**
+ * @fn void ThumbnailLoader::cancelAll(ThumbnailLoader *self)
+ * @memberof ThumbnailLoader
+ */
+static void cancelAll(ThumbnailLoader *self) {
+
+	ThumbnailLoaderQueue *queue = self->queue;
+
+	SDL_LockMutex(queue->lock);
+
+	removeJobs(&queue->pending, NULL);
+	removeJobs(&queue->parked, NULL);
+
+	cancelJobs(queue->running, NULL);
+	cancelJobs(queue->done, NULL);
+
+	SDL_UnlockMutex(queue->lock);
+}
+
+/**
+ * @fn void ThumbnailLoader::cancelItem(ThumbnailLoader *self, const CollectionItemView *item)
+ * @memberof ThumbnailLoader
+ */
+static void cancelItem(ThumbnailLoader *self, const CollectionItemView *item) {
+
+	assert(item);
+
+	ThumbnailLoaderQueue *queue = self->queue;
+
+	SDL_LockMutex(queue->lock);
+
+	removeJobs(&queue->pending, item);
+	removeJobs(&queue->parked, item);
+
+	cancelJobs(queue->running, item);
+	cancelJobs(queue->done, item);
+
+	SDL_UnlockMutex(queue->lock);
+}
+
+/**
+ * @fn void ThumbnailLoader::dispatch(ThumbnailLoader *self)
+ * @memberof ThumbnailLoader
+ */
+static void dispatch(ThumbnailLoader *self) {
+
+	ThumbnailLoaderQueue *queue = self->queue;
+
+	SDL_LockMutex(queue->lock);
+
+	ThumbnailLoaderJob *done = queue->done;
+	queue->done = NULL;
+
+	moveJobs(&queue->pending, &queue->parked, false);
+
+	if (moveJobs(&queue->parked, &queue->pending, true)) {
+		SDL_CondBroadcast(queue->condition);
+	}
+
+	SDL_UnlockMutex(queue->lock);
+
+	while (done) {
+
+		ThumbnailLoaderJob *job = done;
+		done = job->next;
+
+		if (job->cancelled == false && job->surface) {
+
+			Image *image = $(alloc(Image), initWithSurface, job->surface);
+			assert(image);
+
+			insertEntry(self->cache, job->name, image);
+
+			$(job->item->imageView, setImage, image);
+
+			release(image);
+		}
+
+		freeJob(job);
+	}
+}
+
+/**
+ * @fn ThumbnailLoader *ThumbnailLoader::initWithSize(ThumbnailLoader *self, const SDL_Size *size, size_t capacity)
+ * @memberof ThumbnailLoader
+ */
+static ThumbnailLoader *initWithSize(ThumbnailLoader *self, const SDL_Size *size, size_t capacity) {
+
+	self = (ThumbnailLoader *) super(Object, self, init);
+	if (self) {
+
+		if (size) {
+			self->size = *size;
+		}
+
+		self->cache = calloc(1, sizeof(ThumbnailLoaderCache));
+		assert(self->cache);
+
+		self->cache->capacity = capacity ?: DEFAULT_THUMBNAIL_LOADER_CAPACITY;
+		self->cache->numberOfBuckets = self->cache->capacity * 2;
+
+		self->cache->buckets = calloc(self->cache->numberOfBuckets, sizeof(ThumbnailLoaderEntry *));
+		assert(self->cache->buckets);
+
+		ThumbnailLoaderQueue *queue = self->queue = calloc(1, sizeof(ThumbnailLoaderQueue));
+		assert(queue);
+
+		queue->lock = SDL_CreateMutex();
+		assert(queue->lock);
+
+		queue->condition = SDL_CreateCond();
+		assert(queue->condition);
+
+		queue->numberOfThreads = clamp(SDL_GetCPUCount() - 1, 1, MAX_THUMBNAIL_LOADER_THREADS);
+
+		for (int i = 0; i < queue->numberOfThreads; i++) {
+			queue->threads[i] = SDL_CreateThread(workerThread, "ThumbnailLoader", queue);
+			assert(queue->threads[i]);
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @fn void ThumbnailLoader::loadImageForItem(ThumbnailLoader *self, CollectionItemView *item, const char *name)
+ * @memberof ThumbnailLoader
+ */
+static void loadImageForItem(ThumbnailLoader *self, CollectionItemView *item, const char *name) {
+
+	assert(item);
+	assert(name);
+
+	$(self, cancelItem, item);
+
+	const ThumbnailLoaderEntry *entry = lookupEntry(self->cache, name);
+	if (entry) {
+		$(item->imageView, setImage, entry->image);
+		return;
+	}
+
+	$(item->imageView, setImage, self->placeholder);
+
+	ThumbnailLoaderJob *job = calloc(1, sizeof(ThumbnailLoaderJob));
+	assert(job);
+
+	job->name = strdup(name);
+	assert(job->name);
+
+	job->item = retain(item);
+	job->size = self->size;
+
+	ThumbnailLoaderQueue *queue = self->queue;
+
+	SDL_LockMutex(queue->lock);
+
+	job->next = queue->pending;
+	queue->pending = job;
+
+	SDL_CondSignal(queue->condition);
+	SDL_UnlockMutex(queue->lock);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
+
+	((ThumbnailLoaderInterface *) clazz->def->interface)->cancelAll = cancelAll;
+	((ThumbnailLoaderInterface *) clazz->def->interface)->cancelItem = cancelItem;
+	((ThumbnailLoaderInterface *) clazz->def->interface)->dispatch = dispatch;
+	((ThumbnailLoaderInterface *) clazz->def->interface)->initWithSize = initWithSize;
+	((ThumbnailLoaderInterface *) clazz->def->interface)->loadImageForItem = loadImageForItem;
+}
+
+/**
+ * @fn Class *ThumbnailLoader::_ThumbnailLoader(void)
+ * @memberof ThumbnailLoader
+ */
+Class *_ThumbnailLoader(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "ThumbnailLoader";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(ThumbnailLoader);
+		clazz.interfaceOffset = offsetof(ThumbnailLoader, interface);
+		clazz.interfaceSize = sizeof(ThumbnailLoaderInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,158 @@
+/*
+ * ObjectivelyMVC: MVC framework for OpenGL and SDL2 in c.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Object.h>
+
+#include <ObjectivelyMVC/CollectionItemView.h>
+#include <ObjectivelyMVC/Image.h>
+
+/**
+ * @file
+ * @brief The ThumbnailLoader type.
+ */
+
+#define DEFAULT_THUMBNAIL_LOADER_CAPACITY 512
+#define MAX_THUMBNAIL_LOADER_THREADS 4
+
+typedef struct ThumbnailLoaderCache ThumbnailLoaderCache;
+typedef struct ThumbnailLoaderQueue ThumbnailLoaderQueue;
+
+typedef struct ThumbnailLoader ThumbnailLoader;
+typedef struct ThumbnailLoaderInterface ThumbnailLoaderInterface;
+
+/**
+ * @brief ThumbnailLoaders asynchronously load downscaled images for CollectionItemViews.
+ * @details Images are decoded and scaled to fit `size` on worker threads, and then delivered to
+ * their items on the thread calling `dispatch`. Until then, items display the `placeholder`.
+ * Requests for items that are scrolled out of view are deferred until they are visible again, and
+ * the most recently used thumbnails are cached.
+ * @extends Object
+ * @ingroup CollectionViews
+ */
+struct ThumbnailLoader {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Object object;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	ThumbnailLoaderInterface *interface;
+
+	/**
+	 * @brief The cache of recently used thumbnails.
+	 * @private
+	 */
+	ThumbnailLoaderCache *cache;
+
+	/**
+	 * @brief The placeholder Image, displayed while thumbnails load, or `NULL`.
+	 */
+	Image *placeholder;
+
+	/**
+	 * @brief The worker threads and their requests.
+	 * @private
+	 */
+	ThumbnailLoaderQueue *queue;
+
+	/**
+	 * @brief The size that thumbnails are scaled to fit.
+	 */
+	SDL_Size size;
+};
+
+/**
+ * @brief The ThumbnailLoader interface.
+ */
+struct ThumbnailLoaderInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @fn void ThumbnailLoader::cancelAll(ThumbnailLoader *self)
+	 * @brief Cancels all outstanding requests.
+	 * @param self The ThumbnailLoader.
+	 * @memberof ThumbnailLoader
+	 */
+	void (*cancelAll)(ThumbnailLoader *self);
+
+	/**
+	 * @fn void ThumbnailLoader::cancelItem(ThumbnailLoader *self, const CollectionItemView *item)
+	 * @brief Cancels any outstanding request for the given item.
+	 * @param self The ThumbnailLoader.
+	 * @param item The CollectionItemView.
+	 * @memberof ThumbnailLoader
+	 */
+	void (*cancelItem)(ThumbnailLoader *self, const CollectionItemView *item);
+
+	/**
+	 * @fn void ThumbnailLoader::dispatch(ThumbnailLoader *self)
+	 * @brief Delivers loaded thumbnails to their items, and defers or resumes requests according to
+	 * the visibility of their items.
+	 * @param self The ThumbnailLoader.
+	 * @remarks This method must be called from the thread that renders the items, typically once
+	 * per frame. CollectionViews call it for their `thumbnailLoader`.
+	 * @memberof ThumbnailLoader
+	 */
+	void (*dispatch)(ThumbnailLoader *self);
+
+	/**
+	 * @fn ThumbnailLoader *ThumbnailLoader::initWithSize(ThumbnailLoader *self, const SDL_Size *size, size_t capacity)
+	 * @brief Initializes this ThumbnailLoader.
+	 * @param self The ThumbnailLoader.
+	 * @param size The size that thumbnails are scaled to fit.
+	 * @param capacity The count of thumbnails to cache.
+	 * @return The initialized ThumbnailLoader, or `NULL` on error.
+	 * @memberof ThumbnailLoader
+	 */
+	ThumbnailLoader *(*initWithSize)(ThumbnailLoader *self, const SDL_Size *size, size_t capacity);
+
+	/**
+	 * @fn void ThumbnailLoader::loadImageForItem(ThumbnailLoader *self, CollectionItemView *item, const char *name)
+	 * @brief Loads the thumbnail of the named image resource for the given item.
+	 * @param self The ThumbnailLoader.
+	 * @param item The CollectionItemView.
+	 * @param name The image resource name.
+	 * @remarks Cached thumbnails are displayed immediately. Otherwise, the item displays the
+	 * placeholder, and any previous request for the item is cancelled.
+	 * @memberof ThumbnailLoader
+	 */
+	void (*loadImageForItem)(ThumbnailLoader *self, CollectionItemView *item, const char *name);
+};
+
+/**
+ * @fn Class *ThumbnailLoader::_ThumbnailLoader(void)
+ * @brief The ThumbnailLoader archetype.
+ * @return The ThumbnailLoader Class.
+ * @memberof ThumbnailLoader
+ */
+OBJECTIVELYMVC_EXPORT Class *_ThumbnailLoader(void);
@@ -49,10 +49,235 @@ const EnumName ViewAutoresizingNames[] = MakeEnumNames(
 	MakeEnumName(ViewAutoresizingContain)
 );
 
+const ViewFlex ViewFlexDefaults = {
+	.basis = -1,
+	.shrink = 1.0
+};
+
+const ViewGridCell ViewGridCellDefaults = {
+	.column = -1,
+	.columnSpan = 1,
+	.row = -1,
+	.rowSpan = 1
+};
+
 static View *_firstResponder;
 
 static __thread Outlet *_outlets;
 
+static LayoutQueue *_layoutQueue;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PrefetchView(view) __builtin_prefetch(view)
+#else
+#define PrefetchView(view)
+#endif
+
+/**
+ * @brief The layout inputs of a View, as recorded in a ViewLayoutSignature.
+ * @remarks Nodes are zeroed before they are populated, so that signatures may be compared with
+ * `memcmp`.
+ */
+typedef struct {
+
+	/**
+	 * @brief The Class.
+	 */
+	const Class *clazz;
+
+	/**
+	 * @brief The frame, or the frame size for the root of the subtree.
+	 */
+	SDL_Rect frame;
+
+	/**
+	 * @brief The padding.
+	 */
+	ViewPadding padding;
+
+	/**
+	 * @brief The flex item properties.
+	 */
+	ViewFlex flex;
+
+	/**
+	 * @brief The grid cell properties.
+	 */
+	ViewGridCell gridCell;
+
+	/**
+	 * @brief The size that fits a leaf View whose class overrides View::sizeThatFits, or zero.
+	 */
+	SDL_Size size;
+
+	/**
+	 * @brief The alignment, autoresizing mask and hidden state.
+	 */
+	int alignment, autoresizingMask, hidden;
+
+	/**
+	 * @brief The count of subviews.
+	 */
+	int numberOfSubviews;
+
+	/**
+	 * @brief The count of states written by View::layoutState.
+	 */
+	int numberOfStates;
+} ViewLayoutNode;
+
+/**
+ * @brief The structural signature of a View subtree, in preorder.
+ * @remarks The nodes and states reside in the layout scratch of the calling thread.
+ */
+typedef struct {
+
+	/**
+	 * @brief The offset of the first node in the layout scratch.
+	 */
+	size_t nodes;
+
+	/**
+	 * @brief The count of nodes, or `0` if this signature is empty.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The offset of the first state in the layout scratch.
+	 */
+	size_t states;
+
+	/**
+	 * @brief The count of states.
+	 */
+	size_t numberOfStates;
+
+	/**
+	 * @brief The hash of the nodes and states.
+	 */
+	uint32_t hash;
+} ViewLayoutSignature;
+
+/**
+ * @brief An entry in the traversal stack.
+ */
+typedef struct {
+
+	/**
+	 * @brief The View.
+	 */
+	View *view;
+
+	/**
+	 * @brief True if the View should be drawn, false otherwise.
+	 * @remarks Once its descendants have been visited, this is true if the View's override of
+	 * View::draw must be called.
+	 */
+	_Bool draw;
+
+	/**
+	 * @brief True if the View should be laid out, false if its subtree was laid out by `job`.
+	 */
+	_Bool layout;
+
+	/**
+	 * @brief True if the View's descendants have been visited.
+	 */
+	_Bool didVisitSubviews;
+
+	/**
+	 * @brief The LayoutQueue job laying out the View's subtree, or `NULL`.
+	 */
+	LayoutQueueJob *job;
+
+	/**
+	 * @brief The signature of the View's subtree before it was laid out, to be added to the
+	 * layout cache once its descendants have been visited, or empty.
+	 */
+	ViewLayoutSignature signature;
+} ViewTraversalEntry;
+
+/**
+ * @brief The traversal stack of the calling thread, shared by nested traversals.
+ */
+static __thread struct {
+	ViewTraversalEntry *entries;
+	size_t count, capacity;
+} _traversal;
+
+/**
+ * @brief The View whose override of View::draw is being called by the traversal on the calling
+ * thread, or `NULL`.
+ */
+static __thread View *_drawingView;
+
+/**
+ * @brief The layout scratch of the calling thread, which holds the signatures of the subtrees
+ * being laid out, and the frames of the subtree being cached, so that layout does not allocate.
+ * @remarks Signatures are released in the reverse of the order in which they are created, as
+ * the traversal visits them.
+ */
+static __thread struct {
+	ViewLayoutNode *nodes;
+	size_t count, capacity;
+	int *states;
+	size_t numberOfStates, statesCapacity;
+	SDL_Rect *frames;
+	size_t framesCapacity;
+} _layoutScratch;
+
+/**
+ * @brief A laid out subtree in the layout cache.
+ * @remarks The buffers of an entry are reused when it is replaced.
+ */
+typedef struct {
+
+	/**
+	 * @brief The nodes of the subtree's signature before it was laid out.
+	 */
+	ViewLayoutNode *nodes;
+
+	/**
+	 * @brief The states of the subtree's signature.
+	 */
+	int *states;
+
+	/**
+	 * @brief The frames of the subtree after it was laid out, in preorder.
+	 */
+	SDL_Rect *frames;
+
+	/**
+	 * @brief The count of `nodes` and `frames`, or `0` if this entry is empty.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The count of `states`.
+	 */
+	size_t numberOfStates;
+
+	/**
+	 * @brief The capacities of `nodes` and `frames`, and of `states`.
+	 */
+	size_t capacity, statesCapacity;
+
+	/**
+	 * @brief The hash of the signature.
+	 */
+	uint32_t hash;
+} ViewLayoutCacheEntry;
+
+/**
+ * @brief The layout cache, which is shared by all threads, so that subtrees laid out on a
+ * LayoutQueue share hits. Entries are replaced in turn.
+ */
+static struct {
+	ViewLayoutCacheEntry entries[VIEW_LAYOUT_CACHE_CAPACITY];
+	size_t next;
+	SDL_SpinLock lock;
+} _layoutCache;
+
 #define _Class _View
 
 #pragma mark - ObjectInterface
@@ -64,11 +289,16 @@ static void dealloc(Object *self) {
 
 	View *this = (View *) self;
 
+	free(this->flex);
+	free(this->gridCell);
 	free(this->identifier);
 
 	$(this, removeFromSuperview);
 
-	release(this->subviews);
+	if (this->subviews) {
+		$(this, removeAllSubviews);
+		release(this->subviews);
+	}
 
 	super(Object, self, dealloc);
 }
@@ -85,6 +315,67 @@ static String *description(const Object *self) {
 
 #pragma mark - View
 
+/**
+ * @return This View's subviews, allocating them on demand.
+ * @remarks Most Views are leaves, so subviews are not allocated until the first one is added.
+ */
+static MutableArray *mutableSubviews(View *self) {
+
+	if (self->subviews == NULL) {
+		self->subviews = $$(MutableArray, arrayWithCapacity, VIEW_SUBVIEWS_INITIAL_CAPACITY);
+		assert(self->subviews);
+	}
+
+	return self->subviews;
+}
+
+/**
+ * @brief Invalidates the subview indexes of this View's subviews, beginning at the given index.
+ */
+static void invalidateSubviewIndexes(View *self, size_t index) {
+	self->indexedSubviews = min(self->indexedSubviews, index);
+}
+
+/**
+ * @return The index of the given View within its superview's subviews, reindexing the subviews
+ * whose indexes are stale.
+ */
+static size_t indexInSuperview(const View *view) {
+
+	View *superview = view->superview;
+	assert(superview);
+
+	if (view->subviewIndex >= superview->indexedSubviews) {
+
+		const Array *subviews = (Array *) superview->subviews;
+		for (size_t i = superview->indexedSubviews; i < subviews->count; i++) {
+
+			View *subview = $(subviews, objectAtIndex, i);
+			subview->subviewIndex = i;
+		}
+
+		superview->indexedSubviews = subviews->count;
+	}
+
+	assert($((Array *) superview->subviews, objectAtIndex, view->subviewIndex) == view);
+	return view->subviewIndex;
+}
+
+/**
+ * @brief Appends the given subview to this View's subviews, indexing it.
+ */
+static void appendSubview(View *self, View *subview) {
+
+	const size_t count = ((Array *) self->subviews)->count;
+
+	subview->subviewIndex = count;
+	if (self->indexedSubviews == count) {
+		self->indexedSubviews++;
+	}
+
+	$(self->subviews, addObject, subview);
+}
+
 /**
  * @fn void View::addSubview(View *self, View *subview)
  * @memberof View
@@ -102,30 +393,121 @@ static void addSubviewRelativeTo(View *self, View *subview, View *other, ViewPos
 	assert(subview);
 
 	if (subview->superview != self) {
+
+		retain(subview);
+
+		$(subview, removeFromSuperview);
 		subview->superview = self;
 
+		const Array *subviews = (Array *) mutableSubviews(self);
+
 		if (other && other->superview == self) {
 
-			const Array *subviews = (Array *) self->subviews;
-			const ssize_t index = $(subviews, indexOfObject, other);
+			const size_t index = indexInSuperview(other);
 
 			if (position == ViewPositionAfter) {
 				if (index == subviews->count - 1) {
-					$(self->subviews, addObject, subview);
+					appendSubview(self, subview);
 				} else {
 					$(self->subviews, insertObjectAtIndex, subview, index + 1);
+					invalidateSubviewIndexes(self, index + 1);
 				}
 			} else {
 				$(self->subviews, insertObjectAtIndex, subview, index);
+				invalidateSubviewIndexes(self, index);
 			}
 		} else {
-			$(self->subviews, addObject, subview);
+			appendSubview(self, subview);
 		}
 
+		release(subview);
+
 		self->needsLayout = true;
 	}
 }
 
+/**
+ * @fn void View::addSubviews(View *self, const Array *subviews)
+ * @memberof View
+ */
+static void addSubviews(View *self, const Array *subviews) {
+
+	assert(subviews);
+
+	if (subviews->count == 0) {
+		return;
+	}
+
+	mutableSubviews(self);
+
+	for (size_t i = 0; i < subviews->count; i++) {
+
+		View *subview = $(subviews, objectAtIndex, i);
+		if (subview->superview != self) {
+
+			retain(subview);
+
+			$(subview, removeFromSuperview);
+			subview->superview = self;
+
+			appendSubview(self, subview);
+
+			release(subview);
+		}
+	}
+
+	self->needsLayout = true;
+}
+
+/**
+ * @brief Binds the flex item properties of the given View, if the dictionary specifies any.
+ */
+static void awakeWithDictionary_flex(View *self, const Dictionary *dictionary) {
+
+	ViewFlex flex = self->flex ? *self->flex : ViewFlexDefaults;
+
+	const Inlet inlets[] = MakeInlets(
+		MakeInlet("flexBasis", InletTypeInteger, &flex.basis, NULL),
+		MakeInlet("flexGrow", InletTypeFloat, &flex.grow, NULL),
+		MakeInlet("flexShrink", InletTypeFloat, &flex.shrink, NULL),
+		MakeInlet("maxSize", InletTypeSize, &flex.maxSize, NULL),
+		MakeInlet("minSize", InletTypeSize, &flex.minSize, NULL)
+	);
+
+	for (const Inlet *inlet = inlets; inlet->name; inlet++) {
+		if ($(dictionary, objectForKeyPath, inlet->name)) {
+
+			$(self, bind, dictionary, inlets);
+			$(self, setFlex, &flex);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Binds the grid cell properties of the given View, if the dictionary specifies any.
+ */
+static void awakeWithDictionary_gridCell(View *self, const Dictionary *dictionary) {
+
+	ViewGridCell gridCell = self->gridCell ? *self->gridCell : ViewGridCellDefaults;
+
+	const Inlet inlets[] = MakeInlets(
+		MakeInlet("gridColumn", InletTypeInteger, &gridCell.column, NULL),
+		MakeInlet("gridColumnSpan", InletTypeInteger, &gridCell.columnSpan, NULL),
+		MakeInlet("gridRow", InletTypeInteger, &gridCell.row, NULL),
+		MakeInlet("gridRowSpan", InletTypeInteger, &gridCell.rowSpan, NULL)
+	);
+
+	for (const Inlet *inlet = inlets; inlet->name; inlet++) {
+		if ($(dictionary, objectForKeyPath, inlet->name)) {
+
+			$(self, bind, dictionary, inlets);
+			$(self, setGridCell, &gridCell);
+			break;
+		}
+	}
+}
+
 /**
  * @fn void Viem::awakeWithDictionary(View *self, const Dictionary *dictionary, Outlet *outlets)
  * @memberof View
@@ -139,6 +521,9 @@ static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
 		MakeInlet("backgroundColor", InletTypeColor, &self->backgroundColor, NULL),
 		MakeInlet("borderColor", InletTypeColor, &self->borderColor, NULL),
 		MakeInlet("borderWidth", InletTypeInteger, &self->borderWidth, NULL),
+		MakeInlet("cachesLayout", InletTypeBool, &self->cachesLayout, NULL),
+		MakeInlet("concurrentLayout", InletTypeBool, &self->concurrentLayout, NULL),
+		MakeInlet("defersLayoutDuringLiveResize", InletTypeBool, &self->defersLayoutDuringLiveResize, NULL),
 		MakeInlet("frame", InletTypeRectangle, &self->frame, NULL),
 		MakeInlet("hidden", InletTypeBool, &self->hidden, NULL),
 		MakeInlet("padding", InletTypeRectangle, &self->padding, NULL),
@@ -148,6 +533,9 @@ static void awakeWithDictionary(View *self, const Dictionary *dictionary) {
 
 	$(self, bind, dictionary, inlets);
 
+	awakeWithDictionary_flex(self, dictionary);
+	awakeWithDictionary_gridCell(self, dictionary);
+
 	if (self->identifier) {
 		for (Outlet *outlet = _outlets; outlet->identifier; outlet++) {
 			if (strcmp(outlet->identifier, self->identifier) == 0) {
@@ -326,10 +714,434 @@ static _Bool didReceiveEvent(const View *self, const SDL_Event *event) {
 }
 
 /**
- * @brief ArrayEnumerator for draw recursion.
+ * @brief Pushes the given entry onto the traversal stack.
+ */
+static void pushTraversal(const ViewTraversalEntry *entry) {
+
+	if (_traversal.count == _traversal.capacity) {
+		_traversal.capacity = _traversal.capacity ? _traversal.capacity << 1 : 256;
+		_traversal.entries = realloc(_traversal.entries, _traversal.capacity * sizeof(ViewTraversalEntry));
+		assert(_traversal.entries);
+	}
+
+	_traversal.entries[_traversal.count++] = *entry;
+}
+
+/**
+ * @return The View following `view` in a preorder walk of the subtree rooted at `root`, or `NULL`.
+ */
+static View *nextViewInSubtree(const View *root, const View *view) {
+
+	const Array *subviews = (Array *) view->subviews;
+	if (subviews && subviews->count) {
+		return $(subviews, objectAtIndex, 0);
+	}
+
+	while (view != root) {
+
+		const Array *siblings = (Array *) view->superview->subviews;
+		const size_t index = indexInSuperview(view);
+		if (index + 1 < siblings->count) {
+			return $(siblings, objectAtIndex, index + 1);
+		}
+
+		view = view->superview;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Grows the given buffer of `*capacity` elements of `size` bytes to hold `count`.
+ */
+static void *reserveLayoutScratch(void *buffer, size_t *capacity, size_t count, size_t size) {
+
+	if (count > *capacity) {
+		*capacity = max(count, *capacity ? *capacity << 1 : 64);
+
+		buffer = realloc(buffer, *capacity * size);
+		assert(buffer);
+	}
+
+	return buffer;
+}
+
+/**
+ * @brief Appends the layout state of the given View to the layout scratch.
+ * @return The count of states appended.
+ */
+static size_t layoutSignature_states(const View *view) {
+
+	size_t available = _layoutScratch.statesCapacity - _layoutScratch.numberOfStates;
+	size_t count = $(view, layoutState, _layoutScratch.states + _layoutScratch.numberOfStates, available);
+
+	if (count > available) {
+		_layoutScratch.states = reserveLayoutScratch(_layoutScratch.states, &_layoutScratch.statesCapacity, _layoutScratch.numberOfStates + count, sizeof(int));
+
+		available = count;
+		count = $(view, layoutState, _layoutScratch.states + _layoutScratch.numberOfStates, available);
+		assert(count <= available);
+	}
+
+	_layoutScratch.numberOfStates += count;
+	return count;
+}
+
+/**
+ * @return The hash of `length` bytes, continuing from `hash`.
+ */
+static uint32_t layoutSignature_hash(uint32_t hash, const void *data, size_t length) {
+
+	const uint8_t *bytes = data;
+	for (size_t i = 0; i < length; i++) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * @return True if the class of the given View overrides View::sizeThatFits.
+ * @remarks View::sizeThatFits depends only on the frame and autoresizing mask of a leaf View,
+ * which its node already records.
  */
-static void draw_recurse(const Array *array, ident obj, ident data) {
-	$((View *) obj, draw, (Renderer *) data);
+static _Bool overridesSizeThatFits(const View *view) {
+	return view->interface->sizeThatFits != ((ViewInterface *) _View()->def->interface)->sizeThatFits;
+}
+
+/**
+ * @return The signature of the subtree rooted at the given View, as it is now.
+ * @remarks The signature must be released with releaseLayoutSignature.
+ */
+static ViewLayoutSignature layoutSignature(const View *root) {
+
+	ViewLayoutSignature signature = {
+		.nodes = _layoutScratch.count,
+		.states = _layoutScratch.numberOfStates
+	};
+
+	for (const View *view = root; view; view = nextViewInSubtree(root, view)) {
+
+		_layoutScratch.nodes = reserveLayoutScratch(_layoutScratch.nodes, &_layoutScratch.capacity, _layoutScratch.count + 1, sizeof(ViewLayoutNode));
+
+		ViewLayoutNode *node = &_layoutScratch.nodes[_layoutScratch.count++];
+		memset(node, 0, sizeof(*node));
+
+		node->clazz = ((Object *) view)->clazz;
+		node->frame = view->frame;
+		node->padding = view->padding;
+		node->flex = view->flex ? *view->flex : ViewFlexDefaults;
+		node->gridCell = view->gridCell ? *view->gridCell : ViewGridCellDefaults;
+		node->alignment = view->alignment;
+		node->autoresizingMask = view->autoresizingMask;
+		node->hidden = view->hidden;
+
+		if (view->subviews && view->subviews->array.count) {
+			node->numberOfSubviews = (int) view->subviews->array.count;
+		} else if (overridesSizeThatFits(view)) {
+			node->size = $(view, sizeThatFits);
+		}
+
+		node->numberOfStates = (int) layoutSignature_states(view);
+
+		if (view == root) {
+			node->frame.x = node->frame.y = 0;
+		}
+	}
+
+	signature.count = _layoutScratch.count - signature.nodes;
+	signature.numberOfStates = _layoutScratch.numberOfStates - signature.states;
+
+	uint32_t hash = 2166136261u;
+	hash = layoutSignature_hash(hash, _layoutScratch.nodes + signature.nodes, signature.count * sizeof(ViewLayoutNode));
+	hash = layoutSignature_hash(hash, _layoutScratch.states + signature.states, signature.numberOfStates * sizeof(int));
+
+	signature.hash = hash;
+	return signature;
+}
+
+/**
+ * @brief Releases the given signature, which must be the most recently created, from the layout
+ * scratch.
+ */
+static void releaseLayoutSignature(const ViewLayoutSignature *signature) {
+
+	assert(signature->nodes + signature->count == _layoutScratch.count);
+	assert(signature->states + signature->numberOfStates == _layoutScratch.numberOfStates);
+
+	_layoutScratch.count = signature->nodes;
+	_layoutScratch.numberOfStates = signature->states;
+}
+
+/**
+ * @brief Lays out the subtree rooted at the given View from the layout cache, if possible.
+ * @return True if the subtree was laid out from the cache, false otherwise.
+ */
+static _Bool layoutFromCache(View *root, const ViewLayoutSignature *signature) {
+
+	const ViewLayoutNode *nodes = _layoutScratch.nodes + signature->nodes;
+	const int *states = _layoutScratch.states + signature->states;
+
+	_Bool didLayout = false;
+
+	SDL_AtomicLock(&_layoutCache.lock);
+
+	for (size_t i = 0; i < VIEW_LAYOUT_CACHE_CAPACITY; i++) {
+
+		const ViewLayoutCacheEntry *entry = &_layoutCache.entries[i];
+		if (entry->count == 0 || entry->hash != signature->hash) {
+			continue;
+		}
+
+		if (entry->count != signature->count || entry->numberOfStates != signature->numberOfStates) {
+			continue;
+		}
+
+		if (memcmp(entry->nodes, nodes, signature->count * sizeof(ViewLayoutNode))) {
+			continue;
+		}
+
+		if (memcmp(entry->states, states, signature->numberOfStates * sizeof(int))) {
+			continue;
+		}
+
+		const SDL_Rect *frame = entry->frames;
+		for (View *view = root; view; view = nextViewInSubtree(root, view), frame++) {
+
+			if (view == root) {
+				view->frame.w = frame->w;
+				view->frame.h = frame->h;
+			} else {
+				view->frame = *frame;
+			}
+
+			view->needsLayout = false;
+		}
+
+		didLayout = true;
+		break;
+	}
+
+	SDL_AtomicUnlock(&_layoutCache.lock);
+
+	return didLayout;
+}
+
+/**
+ * @brief Adds the subtree rooted at the given View, which has just been laid out, to the layout
+ * cache.
+ * @remarks Subtrees whose structure changed while they were laid out are not cached.
+ */
+static void addToLayoutCache(const View *root, const ViewLayoutSignature *signature) {
+
+	const ViewLayoutNode *nodes = _layoutScratch.nodes + signature->nodes;
+	const int *states = _layoutScratch.states + signature->states;
+
+	_layoutScratch.frames = reserveLayoutScratch(_layoutScratch.frames, &_layoutScratch.framesCapacity, signature->count, sizeof(SDL_Rect));
+
+	size_t count = 0;
+
+	for (const View *view = root; view; view = nextViewInSubtree(root, view)) {
+
+		const ViewLayoutNode *node = &nodes[count];
+
+		const int numberOfSubviews = view->subviews ? (int) view->subviews->array.count : 0;
+		if (count == signature->count
+			|| node->clazz != ((Object *) view)->clazz
+			|| node->numberOfSubviews != numberOfSubviews) {
+			return;
+		}
+
+		_layoutScratch.frames[count++] = view->frame;
+	}
+
+	if (count != signature->count) {
+		return;
+	}
+
+	SDL_AtomicLock(&_layoutCache.lock);
+
+	ViewLayoutCacheEntry *entry = &_layoutCache.entries[_layoutCache.next];
+	_layoutCache.next = (_layoutCache.next + 1) % VIEW_LAYOUT_CACHE_CAPACITY;
+
+	if (entry->capacity < count) {
+		entry->capacity = count;
+
+		entry->nodes = realloc(entry->nodes, count * sizeof(ViewLayoutNode));
+		entry->frames = realloc(entry->frames, count * sizeof(SDL_Rect));
+		assert(entry->nodes && entry->frames);
+	}
+
+	if (entry->statesCapacity < signature->numberOfStates) {
+		entry->statesCapacity = signature->numberOfStates;
+
+		entry->states = realloc(entry->states, signature->numberOfStates * sizeof(int));
+		assert(entry->states);
+	}
+
+	memcpy(entry->nodes, nodes, count * sizeof(ViewLayoutNode));
+	memcpy(entry->states, states, signature->numberOfStates * sizeof(int));
+	memcpy(entry->frames, _layoutScratch.frames, count * sizeof(SDL_Rect));
+
+	entry->count = count;
+	entry->numberOfStates = signature->numberOfStates;
+	entry->hash = signature->hash;
+
+	SDL_AtomicUnlock(&_layoutCache.lock);
+}
+
+/**
+ * @return True if the class of the given View overrides View::draw.
+ */
+static _Bool overridesDraw(const View *view) {
+	return view->interface->draw != ((ViewInterface *) _View()->def->interface)->draw;
+}
+
+/**
+ * @brief Calls the given View's override of View::draw, which draws its laid out subtree.
+ */
+static void drawOverride(View *view, Renderer *renderer) {
+
+	View *drawingView = _drawingView;
+	_drawingView = view;
+
+	$(view, draw, renderer);
+
+	_drawingView = drawingView;
+}
+
+/**
+ * @brief Traverses the hierarchy rooted at the given View in a single pass, with an explicit
+ * stack rather than recursion.
+ * @details Each View is laid out before its subviews are visited, and is added to the Renderer,
+ * if one is given and the View is not hidden, so that the Renderer receives the hierarchy in
+ * order and resolves absolute geometry and clipping as it goes. Hidden subtrees are still laid
+ * out, as View::layoutIfNeeded always has.
+ * @details If a LayoutQueue is installed, subviews with `concurrentLayout` that need layout are
+ * dispatched to it as they are pushed, and joined when they are popped. Their siblings are laid
+ * out meanwhile, and their subtrees are then drawn without being laid out again.
+ * @details During live resize, Views that defer their layout keep `needsLayout` until it ends.
+ * @details Views whose class overrides View::draw have their subtree laid out first, and are then
+ * drawn by calling it. Overrides that call super draw their subtree by a nested traversal, which
+ * does not lay it out again.
+ * @remarks Traversals may nest, e.g. from layoutSubviews, so each one unwinds only to its base.
+ */
+static void traverse(View *root, Renderer *renderer, _Bool layout) {
+
+	const size_t base = _traversal.count;
+	const _Bool liveResize = $(root, inLiveResize);
+
+	pushTraversal(&(const ViewTraversalEntry) {
+		.view = root,
+		.draw = renderer != NULL,
+		.layout = layout
+	});
+
+	while (_traversal.count > base) {
+
+		const ViewTraversalEntry entry = _traversal.entries[--_traversal.count];
+		View *view = entry.view;
+
+		if (entry.didVisitSubviews) {
+			$(view, didLayoutSubviews);
+
+			if (entry.signature.count) {
+				addToLayoutCache(view, &entry.signature);
+				releaseLayoutSignature(&entry.signature);
+			}
+
+			if (entry.draw) {
+				drawOverride(view, renderer);
+			}
+			continue;
+		}
+
+		if (entry.job) {
+			$(_layoutQueue, waitForJob, entry.job);
+		}
+
+		ViewLayoutSignature signature = { .count = 0 };
+
+		if (entry.layout) {
+			$(view, willLayoutSubviews);
+
+			if (view->needsLayout && (liveResize == false || view->defersLayoutDuringLiveResize == false)) {
+
+				if (view->cachesLayout) {
+					signature = layoutSignature(view);
+
+					if (layoutFromCache(view, &signature)) {
+						releaseLayoutSignature(&signature);
+						signature.count = 0;
+					}
+				}
+
+				if (view->needsLayout) {
+					view->needsLayout = false;
+
+					$(view, layoutSubviews);
+				}
+			}
+		}
+
+		_Bool draw = entry.draw && view->hidden == false;
+		_Bool drawsOverride = false;
+
+		if (draw) {
+			if (view != root && overridesDraw(view)) {
+				if (entry.layout == false) {
+					drawOverride(view, renderer);
+					continue;
+				}
+				drawsOverride = true;
+				draw = false;
+			} else {
+				$(renderer, addView, view);
+			}
+		} else if (entry.layout == false) {
+			continue;
+		}
+
+		if (entry.layout) {
+			pushTraversal(&(const ViewTraversalEntry) {
+				.view = view,
+				.draw = drawsOverride,
+				.layout = true,
+				.didVisitSubviews = true,
+				.signature = signature
+			});
+		}
+
+		const Array *subviews = (Array *) view->subviews;
+		if (subviews) {
+			for (ssize_t i = subviews->count - 1; i >= 0; i--) {
+
+				View *subview = $(subviews, objectAtIndex, i);
+				PrefetchView(subview);
+
+				ViewTraversalEntry child = {
+					.view = subview,
+					.draw = draw,
+					.layout = entry.layout
+				};
+
+				if (child.layout && _layoutQueue && subview->concurrentLayout && subview->needsLayout) {
+					child.job = $(_layoutQueue, dispatch, subview);
+					child.layout = false;
+				}
+
+				pushTraversal(&child);
+			}
+		}
+	}
+}
+
+/**
+ * @fn void View::didLayoutSubviews(View *self)
+ * @memberof View
+ */
+static void didLayoutSubviews(View *self) {
+
 }
 
 /**
@@ -340,12 +1152,7 @@ static void draw(View *self, Renderer *renderer) {
 
 	assert(renderer);
 
-	if (self->hidden == false) {
-
-		$(renderer, addView, self);
-
-		$((Array *) self->subviews, enumerateObjects, draw_recurse, renderer);
-	}
+	traverse(self, renderer, self != _drawingView);
 }
 
 /**
@@ -377,9 +1184,6 @@ static View *initWithFrame(View *self, const SDL_Rect *frame) {
 			self->frame = *frame;
 		}
 
-		self->subviews = $$(MutableArray, array);
-		assert(self->subviews);
-
 		self->backgroundColor = Colors.Clear;
 		self->borderColor = Colors.White;
 	}
@@ -387,6 +1191,19 @@ static View *initWithFrame(View *self, const SDL_Rect *frame) {
 	return self;
 }
 
+/**
+ * @fn _Bool View::inLiveResize(const View *self)
+ * @memberof View
+ */
+static _Bool inLiveResize(const View *self) {
+
+	while (self->superview) {
+		self = self->superview;
+	}
+
+	return self->liveResize;
+}
+
 /**
  * @fn _Bool View::isDescendantOfView(const View *self, const View *view)
  * @memberof View
@@ -427,26 +1244,27 @@ static _Bool isVisible(const View *self) {
 }
 
 /**
- * @brief ArrayEnumerator for layoutIfNeeded recursion.
+ * @fn void View::layoutIfNeeded(View *self)
+ * @memberof View
  */
-static void layoutIfNeeded_recurse(const Array *array, ident obj, ident data) {
-	$((View *) obj, layoutIfNeeded);
+static void layoutIfNeeded(View *self) {
+	traverse(self, NULL, true);
 }
 
 /**
- * @fn void View::layoutIfNeeded(View *self)
+ * @fn LayoutQueue *View::layoutQueue(void)
  * @memberof View
  */
-static void layoutIfNeeded(View *self) {
-
-	if (self->needsLayout) {
-		self->needsLayout = false;
-
-		$(self, layoutSubviews);
-	}
+static LayoutQueue *layoutQueue(void) {
+	return _layoutQueue;
+}
 
-	const Array *subviews = (Array *) self->subviews;
-	$(subviews, enumerateObjects, layoutIfNeeded_recurse, NULL);
+/**
+ * @fn size_t View::layoutState(const View *self, int *states, size_t count)
+ * @memberof View
+ */
+static size_t layoutState(const View *self, int *states, size_t count) {
+	return 0;
 }
 
 /**
@@ -459,6 +1277,10 @@ static void layoutSubviews(View *self) {
 		$(self, sizeToContain);
 	}
 
+	if (self->subviews == NULL) {
+		return;
+	}
+
 	const SDL_Rect bounds = $(self, bounds);
 
 	const Array *subviews = (Array *) self->subviews;
@@ -526,6 +1348,27 @@ static void layoutSubviews(View *self) {
 	}
 }
 
+/**
+ * @fn void View::removeAllSubviews(View *self)
+ * @memberof View
+ */
+static void removeAllSubviews(View *self) {
+
+	const Array *subviews = (Array *) self->subviews;
+	if (subviews && subviews->count) {
+
+		for (size_t i = 0; i < subviews->count; i++) {
+			View *subview = $(subviews, objectAtIndex, i);
+			subview->superview = NULL;
+		}
+
+		$(self->subviews, removeAllObjects);
+		self->indexedSubviews = 0;
+
+		self->needsLayout = true;
+	}
+}
+
 /**
  * @fn void View::removeFromSuperview(View *self)
  * @memberof View
@@ -546,9 +1389,13 @@ static void removeSubview(View *self, View *subview) {
 	assert(subview);
 
 	if (subview->superview == self) {
+
+		const size_t index = indexInSuperview(subview);
 		subview->superview = NULL;
 
-		$(self->subviews, removeObject, subview);
+		$(self->subviews, removeObjectAtIndex, index);
+
+		invalidateSubviewIndexes(self, index);
 
 		self->needsLayout = true;
 	}
@@ -597,7 +1444,10 @@ static void renderDeviceDidReset_recurse(const Array *array, ident obj, ident da
  * @memberof View
  */
 static void renderDeviceDidReset(View *self) {
-	$((Array *) self->subviews, enumerateObjects, renderDeviceDidReset_recurse, NULL);
+
+	if (self->subviews) {
+		$((Array *) self->subviews, enumerateObjects, renderDeviceDidReset_recurse, NULL);
+	}
 }
 
 /**
@@ -712,7 +1562,67 @@ static void respondToEvent(View *self, const SDL_Event *event) {
 		}
 	}
 
-	$((Array *) self->subviews, enumerateObjects, respondToEvent_recurse, (ident) event);
+	if (self->subviews) {
+		$((Array *) self->subviews, enumerateObjects, respondToEvent_recurse, (ident) event);
+	}
+}
+
+/**
+ * @fn void View::setFlex(View *self, const ViewFlex *flex)
+ * @memberof View
+ */
+static void setFlex(View *self, const ViewFlex *flex) {
+
+	if (flex) {
+		if (self->flex == NULL) {
+			self->flex = malloc(sizeof(ViewFlex));
+			assert(self->flex);
+		}
+		*self->flex = *flex;
+	} else {
+		free(self->flex);
+		self->flex = NULL;
+	}
+
+	if (self->superview) {
+		self->superview->needsLayout = true;
+	}
+}
+
+/**
+ * @fn void View::setGridCell(View *self, const ViewGridCell *gridCell)
+ * @memberof View
+ */
+static void setGridCell(View *self, const ViewGridCell *gridCell) {
+
+	if (gridCell) {
+		if (self->gridCell == NULL) {
+			self->gridCell = malloc(sizeof(ViewGridCell));
+			assert(self->gridCell);
+		}
+		*self->gridCell = *gridCell;
+	} else {
+		free(self->gridCell);
+		self->gridCell = NULL;
+	}
+
+	if (self->superview) {
+		self->superview->needsLayout = true;
+	}
+}
+
+/**
+ * @fn void View::setLayoutQueue(LayoutQueue *layoutQueue)
+ * @memberof View
+ */
+static void setLayoutQueue(LayoutQueue *layoutQueue) {
+
+	if (layoutQueue != _layoutQueue) {
+
+		release(_layoutQueue);
+
+		_layoutQueue = layoutQueue ? retain(layoutQueue) : NULL;
+	}
 }
 
 /**
@@ -754,10 +1664,14 @@ static SDL_Size sizeThatFits(const View *self) {
 	if (self->autoresizingMask & ViewAutoresizingContain) {
 		size = MakeSize(0, 0);
 
-		Array *subviews = $(self, visibleSubviews);
-		for (size_t i = 0; i < subviews->count; i++) {
+		const Array *subviews = (Array *) self->subviews;
+		for (size_t i = 0; subviews && i < subviews->count; i++) {
 
 			const View *subview = $(subviews, objectAtIndex, i);
+			if (subview->hidden || subview->alignment == ViewAlignmentInternal) {
+				continue;
+			}
+
 			const SDL_Size subviewSize = $(subview, sizeThatContains);
 
 			SDL_Point subviewOrigin = MakePoint(0, 0);
@@ -775,8 +1689,6 @@ static SDL_Size sizeThatFits(const View *self) {
 
 		size.w += self->padding.left + self->padding.right;
 		size.h += self->padding.top + self->padding.bottom;
-
-		release(subviews);
 	}
 
 	return size;
@@ -816,7 +1728,10 @@ static void updateBindings_recurse(const Array *array, ident obj, ident data) {
  * @memberof View
  */
 static void updateBindings(View *self) {
-	$((Array *) self->subviews, enumerateObjects, updateBindings_recurse, NULL);
+
+	if (self->subviews) {
+		$((Array *) self->subviews, enumerateObjects, updateBindings_recurse, NULL);
+	}
 }
 
 /**
@@ -873,6 +1788,8 @@ static View *viewWithDictionary(const Dictionary *dictionary, Outlet *outlets) {
 		_initialize(_Button());
 		_initialize(_Checkbox());
 		_initialize(_CollectionView());
+		_initialize(_FlexView());
+		_initialize(_GridView());
 		_initialize(_ImageView());
 		_initialize(_Input());
 		_initialize(_Label());
@@ -916,7 +1833,12 @@ static _Bool visibleSubviews_filter(ident obj, ident data) {
  * @memberof View
  */
 static Array *visibleSubviews(const View *self) {
-	return $((Array *) self->subviews, filteredArray, visibleSubviews_filter, NULL);
+
+	if (self->subviews) {
+		return $((Array *) self->subviews, filteredArray, visibleSubviews_filter, NULL);
+	}
+
+	return (Array *) $$(MutableArray, array);
 }
 
 /**
@@ -924,9 +1846,23 @@ static Array *visibleSubviews(const View *self) {
  * @memberof View
  */
 static SDL_Window *window(const View *self) {
+
+	const WindowMetrics *metrics = $$(WindowController, currentMetrics);
+	if (metrics) {
+		return metrics->window;
+	}
+
 	return SDL_GL_GetCurrentWindow();
 }
 
+/**
+ * @fn void View::willLayoutSubviews(View *self)
+ * @memberof View
+ */
+static void willLayoutSubviews(View *self) {
+
+}
+
 #pragma mark - View class methods
 
 /**
@@ -939,6 +1875,7 @@ static void initialize(Class *clazz) {
 
 	((ViewInterface *) clazz->def->interface)->addSubview = addSubview;
 	((ViewInterface *) clazz->def->interface)->addSubviewRelativeTo = addSubviewRelativeTo;
+	((ViewInterface *) clazz->def->interface)->addSubviews = addSubviews;
 	((ViewInterface *) clazz->def->interface)->awakeWithDictionary = awakeWithDictionary;
 	((ViewInterface *) clazz->def->interface)->becomeFirstResponder = becomeFirstResponder;
 	((ViewInterface *) clazz->def->interface)->bind = _bind;
@@ -947,16 +1884,21 @@ static void initialize(Class *clazz) {
 	((ViewInterface *) clazz->def->interface)->clippingFrame = clippingFrame;
 	((ViewInterface *) clazz->def->interface)->containsPoint = containsPoint;
 	((ViewInterface *) clazz->def->interface)->depth = depth;
+	((ViewInterface *) clazz->def->interface)->didLayoutSubviews = didLayoutSubviews;
 	((ViewInterface *) clazz->def->interface)->didReceiveEvent = didReceiveEvent;
 	((ViewInterface *) clazz->def->interface)->draw = draw;
 	((ViewInterface *) clazz->def->interface)->firstResponder = firstResponder;
 	((ViewInterface *) clazz->def->interface)->init = init;
 	((ViewInterface *) clazz->def->interface)->initWithFrame = initWithFrame;
+	((ViewInterface *) clazz->def->interface)->inLiveResize = inLiveResize;
 	((ViewInterface *) clazz->def->interface)->isDescendantOfView = isDescendantOfView;
 	((ViewInterface *) clazz->def->interface)->isFirstResponder = isFirstResponder;
 	((ViewInterface *) clazz->def->interface)->isVisible = isVisible;
 	((ViewInterface *) clazz->def->interface)->layoutIfNeeded = layoutIfNeeded;
+	((ViewInterface *) clazz->def->interface)->layoutQueue = layoutQueue;
+	((ViewInterface *) clazz->def->interface)->layoutState = layoutState;
 	((ViewInterface *) clazz->def->interface)->layoutSubviews = layoutSubviews;
+	((ViewInterface *) clazz->def->interface)->removeAllSubviews = removeAllSubviews;
 	((ViewInterface *) clazz->def->interface)->removeFromSuperview = removeFromSuperview;
 	((ViewInterface *) clazz->def->interface)->removeSubview = removeSubview;
 	((ViewInterface *) clazz->def->interface)->render = render;
@@ -965,6 +1907,9 @@ static void initialize(Class *clazz) {
 	((ViewInterface *) clazz->def->interface)->resignFirstResponder = resignFirstResponder;
 	((ViewInterface *) clazz->def->interface)->resize = resize;
 	((ViewInterface *) clazz->def->interface)->respondToEvent = respondToEvent;
+	((ViewInterface *) clazz->def->interface)->setFlex = setFlex;
+	((ViewInterface *) clazz->def->interface)->setGridCell = setGridCell;
+	((ViewInterface *) clazz->def->interface)->setLayoutQueue = setLayoutQueue;
 	((ViewInterface *) clazz->def->interface)->size = size;
 	((ViewInterface *) clazz->def->interface)->sizeThatContains = sizeThatContains;
 	((ViewInterface *) clazz->def->interface)->sizeThatFits = sizeThatFits;
@@ -977,6 +1922,15 @@ static void initialize(Class *clazz) {
 	((ViewInterface *) clazz->def->interface)->viewWithDictionary = viewWithDictionary;
 	((ViewInterface *) clazz->def->interface)->visibleSubviews = visibleSubviews;
 	((ViewInterface *) clazz->def->interface)->window = window;
+	((ViewInterface *) clazz->def->interface)->willLayoutSubviews = willLayoutSubviews;
+}
+
+/**
+ * @see Class::destroy(Class *)
+ */
+static void destroy(Class *clazz) {
+
+	release(_layoutQueue);
 }
 
 /**
@@ -994,6 +1948,7 @@ Class *_View(void) {
 		clazz.interfaceOffset = offsetof(View, interface);
 		clazz.interfaceSize = sizeof(ViewInterface);
 		clazz.initialize = initialize;
+		clazz.destroy = destroy;
 	});
 
 	return &clazz;
@@ -1022,7 +1977,21 @@ SDL_Rect MVC_TransformToWindow(SDL_Window *window, const SDL_Rect *rect) {
 
 double MVC_WindowScale(SDL_Window *window, int *height, int *drawableHeight) {
 
-	window = window ?: SDL_GL_GetCurrentWindow();
+	const WindowMetrics *metrics = $$(WindowController, metricsForWindow, window);
+	if (metrics) {
+
+		if (height) {
+			*height = metrics->size.h;
+		}
+
+		if (drawableHeight) {
+			*drawableHeight = metrics->drawableSize.h;
+		}
+
+		return metrics->scale;
+	}
+
+	window = window ?: SDL_GL_GetCurrentWindow() ?: $$(LayoutQueue, currentWindow);
 	assert(window);
 
 	int h;
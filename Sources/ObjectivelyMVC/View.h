@@ -29,6 +29,7 @@
 #include <Objectively/MutableArray.h>
 
 #include <ObjectivelyMVC/Colors.h>
+#include <ObjectivelyMVC/LayoutQueue.h>
 #include <ObjectivelyMVC/Renderer.h>
 #include <ObjectivelyMVC/View+JSON.h>
 
@@ -45,6 +46,9 @@
 #define ViewAlignmentMaskRight    0x20
 #define ViewAlignmentMaskInternal 0x100
 
+#define VIEW_SUBVIEWS_INITIAL_CAPACITY 4
+#define VIEW_LAYOUT_CACHE_CAPACITY 64
+
 /**
  * @brief Alignment constants, used to align a View within its superview.
  */
@@ -77,6 +81,74 @@ typedef enum {
 
 OBJECTIVELYMVC_EXPORT const EnumName ViewAutoresizingNames[];
 
+/**
+ * @brief Flex item properties, which apply to Views arranged by a FlexView.
+ */
+typedef struct {
+
+	/**
+	 * @brief The size along the main axis before growing or shrinking, or `-1` to use the size
+	 * that contains the View.
+	 */
+	int basis;
+
+	/**
+	 * @brief The share of free space by which the View grows.
+	 */
+	float grow;
+
+	/**
+	 * @brief The share of overflow by which the View shrinks, weighted by its basis.
+	 */
+	float shrink;
+
+	/**
+	 * @brief The minimum size.
+	 */
+	SDL_Size minSize;
+
+	/**
+	 * @brief The maximum size. Components of `0` are unbounded.
+	 */
+	SDL_Size maxSize;
+} ViewFlex;
+
+/**
+ * @brief The flex item properties of Views that have not set any.
+ */
+OBJECTIVELYMVC_EXPORT const ViewFlex ViewFlexDefaults;
+
+/**
+ * @brief Grid cell properties, which apply to Views arranged by a GridView.
+ */
+typedef struct {
+
+	/**
+	 * @brief The column, or `-1` to place the View automatically.
+	 */
+	int column;
+
+	/**
+	 * @brief The count of columns the View spans.
+	 */
+	int columnSpan;
+
+	/**
+	 * @brief The row, or `-1` to place the View automatically.
+	 */
+	int row;
+
+	/**
+	 * @brief The count of rows the View spans.
+	 */
+	int rowSpan;
+} ViewGridCell;
+
+/**
+ * @brief The grid cell properties of Views that have not set any.
+ */
+OBJECTIVELYMVC_EXPORT const ViewGridCell ViewGridCellDefaults;
+
 /**
  * @brief Spacing applied to the inside of a View's frame.
  */
@@ -140,16 +212,57 @@ struct View {
 	 */
 	int borderWidth;
 
+	/**
+	 * @brief If true, this View's subtree is laid out from the layout cache when a structurally
+	 * identical subtree of the same size has already been laid out.
+	 * @details Subtrees are identical when their Views have the same classes, frames, padding,
+	 * alignment, autoresizing and View::layoutState, and their leaves fit the same size. Views
+	 * should only set this if their layout depends on nothing else, as is typical of rows built
+	 * from a template. The cache is shared by all threads, including LayoutQueue workers.
+	 */
+	_Bool cachesLayout;
+
 	/**
 	 * @brief If true, subviews will be clipped to this View's frame.
 	 */
 	_Bool clipsSubviews;
 
+	/**
+	 * @brief If true, this View's subtree shares no mutable state with the rest of the hierarchy,
+	 * and may be laid out on the LayoutQueue while its siblings are laid out.
+	 * @remarks This is off by default. Set it only on subtrees whose layout makes no OpenGL calls,
+	 * e.g. via Text::setText or ImageView::setImage, which delete textures.
+	 * @see View::setLayoutQueue(LayoutQueue *)
+	 */
+	_Bool concurrentLayout;
+
+	/**
+	 * @brief If true, this View is not laid out while its window is being resized interactively.
+	 * @details Its frame still follows its superview, but its subviews keep their frames until the
+	 * size settles. Views whose layout is expensive, such as tables and collections, set this.
+	 * @see View::inLiveResize(const View *)
+	 */
+	_Bool defersLayoutDuringLiveResize;
+
+	/**
+	 * @brief The flex item properties, or `NULL` if ViewFlexDefaults apply.
+	 * @remarks These are allocated only for Views that set them, via View::setFlex.
+	 * @see FlexView
+	 */
+	ViewFlex *flex;
+
 	/**
 	 * @brief The frame, relative to the superview.
 	 */
 	SDL_Rect frame;
 
+	/**
+	 * @brief The grid cell properties, or `NULL` if ViewGridCellDefaults apply.
+	 * @remarks These are allocated only for Views that set them, via View::setGridCell.
+	 * @see GridView
+	 */
+	ViewGridCell *gridCell;
+
 	/**
 	 * @brief If `true`, this View is not drawn.
 	 */
@@ -161,6 +274,20 @@ struct View {
 	 */
 	char *identifier;
 
+	/**
+	 * @brief The count of leading subviews whose `subviewIndex` is current.
+	 * @remarks Subviews following a removed or inserted subview are reindexed lazily.
+	 * @private
+	 */
+	size_t indexedSubviews;
+
+	/**
+	 * @brief True while the window is being resized interactively.
+	 * @remarks This is set on the root View by its WindowController. Use View::inLiveResize to
+	 * query it from any View in the hierarchy.
+	 */
+	_Bool liveResize;
+
 	/**
 	 * @brief If true,
 	 */
@@ -171,8 +298,17 @@ struct View {
 	 */
 	ViewPadding padding;
 
+	/**
+	 * @brief The index of this View within its superview's subviews.
+	 * @remarks This may be stale. See `indexedSubviews`.
+	 * @private
+	 */
+	size_t subviewIndex;
+
 	/**
 	 * @brief All contained views.
+	 * @remarks This is `NULL` until the first subview is added. Subviews are stored contiguously,
+	 * in draw order, so that they may be indexed directly.
 	 */
 	MutableArray *subviews;
 
@@ -219,6 +355,16 @@ struct ViewInterface {
 	 */
 	void (*addSubviewRelativeTo)(View *self, View *subview, View *other, ViewPosition position);
 
+	/**
+	 * @fn void View::addSubviews(View *self, const Array *subviews)
+	 * @brief Adds the given subviews to this View, to be drawn above their siblings.
+	 * @param self The View.
+	 * @param subviews The subviews to add.
+	 * @remarks This method is more efficient than adding each subview individually.
+	 * @memberof View
+	 */
+	void (*addSubviews)(View *self, const Array *subviews);
+
 	/**
 	 * @fn void View::awakeWithDictionary(View *self, const Dictionary *dictionary)
 	 * @brief Wakes this View with the specified Dictionary.
@@ -295,6 +441,16 @@ struct ViewInterface {
 	 */
 	int (*depth)(const View *self);
 
+	/**
+	 * @fn void View::didLayoutSubviews(View *self)
+	 * @brief Called each time this View and all of its descendants have been laid out.
+	 * @param self The View.
+	 * @remarks This method is called on every traversal, whether or not the layout changed.
+	 * Subclasses may override it to act on the up-to-date frames of their descendants.
+	 * @memberof View
+	 */
+	void (*didLayoutSubviews)(View *self);
+
 	/**
 	 * @fn _Bool View::didReceiveEvent(const View *self, const SDL_Event *event)
 	 * @param self The View.
@@ -306,11 +462,15 @@ struct ViewInterface {
 
 	/**
 	 * @fn void View::draw(View *self, Renderer *renderer)
-	 * @brief Draws this View.
+	 * @brief Lays out and draws this View and its descendants.
 	 * @param self The View.
 	 * @param renderer The Renderer with which to draw.
-	 * @remarks The default implementation of this method adds the View to the Renderer for the
-	 * current frame, and recurses its subviews. Rasterization is performed in View::render.
+	 * @remarks The default implementation of this method traverses the hierarchy once, without
+	 * recursion, laying out each View as View::layoutIfNeeded would and adding each visible View
+	 * to the Renderer for the current frame. Overrides on Views within the hierarchy are called
+	 * once their subtree is laid out, and their call to super draws the subtree without laying it
+	 * out again. Per-View customization otherwise belongs in View::willLayoutSubviews,
+	 * View::layoutSubviews or View::render. Rasterization is performed in View::render.
 	 * @see View::render(View *, Renderer *)
 	 * @memberof View
 	 */
@@ -347,6 +507,14 @@ struct ViewInterface {
 	 */
 	View *(*initWithFrame)(View *self, const SDL_Rect *frame);
 
+	/**
+	 * @fn _Bool View::inLiveResize(const View *self)
+	 * @param self The View.
+	 * @return True if this View's window is being resized interactively.
+	 * @memberof View
+	 */
+	_Bool (*inLiveResize)(const View *self);
+
 	/**
 	 * @fn _Bool View::isDescendantOfView(const View *self, const View *view)
 	 * @param self The View.
@@ -376,10 +544,34 @@ struct ViewInterface {
 	 * @fn void View::layoutIfNeeded(View *self)
 	 * @brief Recursively updates the layout of this View and its subviews.
 	 * @param self The View.
+	 * @remarks The hierarchy is traversed without recursion. Each View's willLayoutSubviews,
+	 * layoutSubviews (if needed) and didLayoutSubviews are called in turn.
 	 * @memberof View
 	 */
 	void (*layoutIfNeeded)(View *self);
 
+	/**
+	 * @static
+	 * @fn LayoutQueue *View::layoutQueue(void)
+	 * @return The LayoutQueue on which subtrees with `concurrentLayout` are laid out, or `NULL`.
+	 * @memberof View
+	 */
+	LayoutQueue *(*layoutQueue)(void);
+
+	/**
+	 * @fn size_t View::layoutState(const View *self, int *states, size_t count)
+	 * @brief Writes the state of this View, beyond its View properties, that determines the
+	 * layout of its subviews.
+	 * @param self The View.
+	 * @param states The states, or `NULL`.
+	 * @param count The maximum count of states to write.
+	 * @return The count of states this View has, which may exceed `count`.
+	 * @remarks Subclasses with such state, e.g. the axis of a StackView, must override this method,
+	 * so that the layout cache distinguishes subtrees that differ only in it.
+	 * @memberof View
+	 */
+	size_t (*layoutState)(const View *self, int *states, size_t count);
+
 	/**
 	 * @fn View::layoutSubviews(View *self)
 	 * @brief Updates the frame of this View's hierarchy using the installed Constraints.
@@ -388,6 +580,14 @@ struct ViewInterface {
 	 */
 	void (*layoutSubviews)(View *self);
 
+	/**
+	 * @fn void View::removeAllSubviews(View *self)
+	 * @brief Removes all subviews from this View.
+	 * @param self The View.
+	 * @memberof View
+	 */
+	void (*removeAllSubviews)(View *self);
+
 	/**
 	 * @fn void View::removeFromSuperview(View *self)
 	 * @brief Removes this View from its superview.
@@ -401,6 +601,10 @@ struct ViewInterface {
 	 * @brief Removes the given subview from this View.
 	 * @param self The View.
 	 * @param subview The subview.
+	 * @remarks The subview is found in O(1), but removing any subview other than the last is O(n),
+	 * because the contiguous `subviews` array is shifted to close the gap. Reindexing the subviews
+	 * after it is deferred to the next lookup. To remove many subviews, prefer
+	 * View::removeAllSubviews(View *), which is linear in their count.
 	 * @memberof View
 	 */
 	void (*removeSubview)(View *self, View *subview);
@@ -460,6 +664,35 @@ struct ViewInterface {
 	 */
 	void (*respondToEvent)(View *self, const SDL_Event *event);
 
+	/**
+	 * @fn void View::setFlex(View *self, const ViewFlex *flex)
+	 * @brief Sets the flex item properties of this View.
+	 * @param self The View.
+	 * @param flex The flex item properties, or `NULL` to restore ViewFlexDefaults.
+	 * @memberof View
+	 */
+	void (*setFlex)(View *self, const ViewFlex *flex);
+
+	/**
+	 * @fn void View::setGridCell(View *self, const ViewGridCell *gridCell)
+	 * @brief Sets the grid cell properties of this View.
+	 * @param self The View.
+	 * @param gridCell The grid cell properties, or `NULL` to restore ViewGridCellDefaults.
+	 * @memberof View
+	 */
+	void (*setGridCell)(View *self, const ViewGridCell *gridCell);
+
+	/**
+	 * @static
+	 * @fn void View::setLayoutQueue(LayoutQueue *layoutQueue)
+	 * @brief Sets the LayoutQueue on which subtrees with `concurrentLayout` are laid out.
+	 * @param layoutQueue The LayoutQueue, or `NULL` to lay out all Views on the calling thread.
+	 * @remarks Subtrees are dispatched once their superview has been laid out, and are joined
+	 * before they are drawn. The LayoutQueue must not be changed during a traversal.
+	 * @memberof View
+	 */
+	void (*setLayoutQueue)(LayoutQueue *layoutQueue);
+
 	/**
 	 * @fn SDL_Size View::size(const View *self)
 	 * @param self The View.
@@ -572,6 +805,16 @@ struct ViewInterface {
 	 * @memberof View
 	 */
 	SDL_Window *(*window)(const View *self);
+
+	/**
+	 * @fn void View::willLayoutSubviews(View *self)
+	 * @brief Called each time this View is visited to be laid out, before its subviews.
+	 * @param self The View.
+	 * @remarks This method is called on every traversal, whether or not this View needs layout.
+	 * Subclasses may override it to apply pending changes, or to set `needsLayout`.
+	 * @memberof View
+	 */
+	void (*willLayoutSubviews)(View *self);
 };
 
 OBJECTIVELYMVC_EXPORT Class *_View(void);
@@ -592,6 +835,8 @@ OBJECTIVELYMVC_EXPORT SDL_Rect MVC_TransformToWindow(SDL_Window *window, const S
  * @return The scale factor of the specified window.
  * @remarks Views and other classes should invoke this method to alter their rendering behavior for
  * High-DPI displays. This is particularly relevant for Views that render textures.
+ * @remarks The current WindowController's cached metrics are used when they describe `window`, so
+ * that only other windows are queried from SDL.
  */
 OBJECTIVELYMVC_EXPORT double MVC_WindowScale(SDL_Window *window, int *height, int *drawableHeight);
 
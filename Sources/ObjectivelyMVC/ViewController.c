@@ -56,8 +56,6 @@ static void drawView(ViewController *self, Renderer *renderer) {
 
 	assert(self->view);
 
-	$(self->view, layoutIfNeeded);
-
 	$(self->view, draw, renderer);
 }
 
@@ -28,6 +28,16 @@
 
 #define _Class _WindowController
 
+/**
+ * @brief The metrics of the window being rendered, or responding to events, on the calling thread.
+ */
+static __thread const WindowMetrics *_currentMetrics;
+
+/**
+ * @brief The key under which a WindowController is stored in its window's data.
+ */
+#define WINDOW_CONTROLLER_DATA "WindowController"
+
 #pragma mark - Object
 
 /**
@@ -37,6 +47,14 @@ static void dealloc(Object *self) {
 
 	WindowController *this = (WindowController *) self;
 
+	if (_currentMetrics == &this->metrics) {
+		_currentMetrics = NULL;
+	}
+
+	if (SDL_GetWindowData(this->window, WINDOW_CONTROLLER_DATA) == this) {
+		SDL_SetWindowData(this->window, WINDOW_CONTROLLER_DATA, NULL);
+	}
+
 	release(this->renderer);
 	release(this->viewController);
 
@@ -45,6 +63,26 @@ static void dealloc(Object *self) {
 
 #pragma mark - WindowController
 
+/**
+ * @fn const WindowMetrics *WindowController::currentMetrics(void)
+ * @memberof WindowController
+ */
+static const WindowMetrics *currentMetrics(void) {
+	return _currentMetrics;
+}
+
+/**
+ * @brief Begins or ends live resize, propagating it to the ViewController's View.
+ */
+static void setLiveResize(WindowController *self, _Bool liveResize) {
+
+	self->liveResize = liveResize;
+
+	if (self->viewController && self->viewController->view) {
+		self->viewController->view->liveResize = liveResize;
+	}
+}
+
 /**
  * @fn WindowController *WindowController::initWithWindow(WindowController *self, SDL_Window *window)
  * @memberof WindowController
@@ -62,11 +100,50 @@ static WindowController *initWithWindow(WindowController *self, SDL_Window *wind
 
 		self->renderer = $(alloc(Renderer), init);
 		assert(self->renderer);
+
+		self->liveResizeDelay = WINDOW_CONTROLLER_LIVE_RESIZE_DELAY;
+
+		SDL_SetWindowData(self->window, WINDOW_CONTROLLER_DATA, self);
+
+		$(self, updateMetrics);
 	}
 
 	return self;
 }
 
+/**
+ * @fn const WindowMetrics *WindowController::makeMetricsCurrent(const WindowMetrics *metrics)
+ * @memberof WindowController
+ */
+static const WindowMetrics *makeMetricsCurrent(const WindowMetrics *metrics) {
+
+	const WindowMetrics *previous = _currentMetrics;
+
+	_currentMetrics = metrics;
+
+	return previous;
+}
+
+/**
+ * @fn const WindowMetrics *WindowController::metricsForWindow(SDL_Window *window)
+ * @memberof WindowController
+ */
+static const WindowMetrics *metricsForWindow(SDL_Window *window) {
+
+	if (_currentMetrics && (window == NULL || window == _currentMetrics->window)) {
+		return _currentMetrics;
+	}
+
+	if (window) {
+		const WindowController *windowController = SDL_GetWindowData(window, WINDOW_CONTROLLER_DATA);
+		if (windowController) {
+			return &windowController->metrics;
+		}
+	}
+
+	return NULL;
+}
+
 /**
  * @fn void WindowController::setRenderer(WindowController *self, Renderer *renderer)
  * @memberof WindowController
@@ -104,6 +181,8 @@ static void setViewController(WindowController *self, ViewController *viewContro
 		if (self->viewController) {
 			$(self->viewController, loadViewIfNeeded);
 		}
+
+		setLiveResize(self, self->liveResize);
 	}
 }
 
@@ -115,6 +194,14 @@ static void render(WindowController *self) {
 
 	assert(self->renderer);
 
+	$(self, updateMetrics);
+
+	const WindowMetrics *metrics = $$(WindowController, makeMetricsCurrent, &self->metrics);
+
+	if (self->liveResize) {
+		setLiveResize(self, SDL_TICKS_PASSED(SDL_GetTicks(), self->liveResizeTime + self->liveResizeDelay) == false);
+	}
+
 	$(self->renderer, beginFrame);
 
 	if (self->viewController) {
@@ -125,6 +212,8 @@ static void render(WindowController *self) {
 	}
 
 	$(self->renderer, endFrame);
+
+	$$(WindowController, makeMetricsCurrent, metrics);
 }
 
 /**
@@ -134,6 +223,13 @@ static void render(WindowController *self) {
 static void respondToEvent(WindowController *self, const SDL_Event *event) {
 
 	if (event->type == SDL_WINDOWEVENT) {
+		$(self, updateMetrics);
+	}
+
+	const WindowMetrics *metrics = $$(WindowController, makeMetricsCurrent, &self->metrics);
+
+	if (event->type == SDL_WINDOWEVENT) {
+
 		if (event->window.event == SDL_WINDOWEVENT_SHOWN) {
 
 			if (self->renderer) {
@@ -143,12 +239,39 @@ static void respondToEvent(WindowController *self, const SDL_Event *event) {
 			if (self->viewController) {
 				$(self->viewController, renderDeviceDidReset);
 			}
+		} else if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+
+			self->liveResizeTime = SDL_GetTicks();
+
+			setLiveResize(self, true);
 		}
 	}
 
 	if (self->viewController) {
 		$(self->viewController, respondToEvent, event);
 	}
+
+	$$(WindowController, makeMetricsCurrent, metrics);
+}
+
+/**
+ * @fn void WindowController::updateMetrics(WindowController *self)
+ * @memberof WindowController
+ */
+static void updateMetrics(WindowController *self) {
+
+	WindowMetrics *metrics = &self->metrics;
+
+	metrics->window = self->window;
+
+	SDL_GetWindowSize(self->window, &metrics->size.w, &metrics->size.h);
+	SDL_GL_GetDrawableSize(self->window, &metrics->drawableSize.w, &metrics->drawableSize.h);
+
+	if (metrics->size.h && metrics->drawableSize.h) {
+		metrics->scale = metrics->drawableSize.h / (double) metrics->size.h;
+	} else {
+		metrics->scale = 1.0;
+	}
 }
 
 #pragma mark - Class lifecycle
@@ -160,11 +283,15 @@ static void initialize(Class *clazz) {
 
 	((ObjectInterface *) clazz->def->interface)->dealloc = dealloc;
 
+	((WindowControllerInterface *) clazz->def->interface)->currentMetrics = currentMetrics;
 	((WindowControllerInterface *) clazz->def->interface)->initWithWindow = initWithWindow;
+	((WindowControllerInterface *) clazz->def->interface)->makeMetricsCurrent = makeMetricsCurrent;
+	((WindowControllerInterface *) clazz->def->interface)->metricsForWindow = metricsForWindow;
 	((WindowControllerInterface *) clazz->def->interface)->render = render;
 	((WindowControllerInterface *) clazz->def->interface)->respondToEvent = respondToEvent;
 	((WindowControllerInterface *) clazz->def->interface)->setRenderer = setRenderer;
 	((WindowControllerInterface *) clazz->def->interface)->setViewController = setViewController;
+	((WindowControllerInterface *) clazz->def->interface)->updateMetrics = updateMetrics;
 }
 
 /**
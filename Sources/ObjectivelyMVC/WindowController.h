@@ -32,6 +32,34 @@
  * @brief A WindowController manages a ViewController and its descendants within an SDL_Window.
  */
 
+#define WINDOW_CONTROLLER_LIVE_RESIZE_DELAY 200
+
+/**
+ * @brief The metrics of a window, captured by its WindowController.
+ */
+typedef struct {
+
+	/**
+	 * @brief The window.
+	 */
+	SDL_Window *window;
+
+	/**
+	 * @brief The window size, in points.
+	 */
+	SDL_Size size;
+
+	/**
+	 * @brief The drawable size, in pixels.
+	 */
+	SDL_Size drawableSize;
+
+	/**
+	 * @brief The ratio of drawable height to window height, for High-DPI support.
+	 */
+	double scale;
+} WindowMetrics;
+
 typedef struct WindowController WindowController;
 typedef struct WindowControllerInterface WindowControllerInterface;
 
@@ -53,6 +81,33 @@ struct WindowController {
 	 */
 	WindowControllerInterface *interface;
 
+	/**
+	 * @brief True while the window is being resized interactively.
+	 * @details Live resize begins with the first size change, and ends once the size has settled
+	 * for `liveResizeDelay` milliseconds. Until then, Views that defer their layout during live
+	 * resize are not laid out.
+	 * @see View::defersLayoutDuringLiveResize
+	 */
+	_Bool liveResize;
+
+	/**
+	 * @brief The interval, in milliseconds, that the window size must settle for before live
+	 * resize ends.
+	 */
+	Uint32 liveResizeDelay;
+
+	/**
+	 * @brief The ticks at which the window size last changed.
+	 * @private
+	 */
+	Uint32 liveResizeTime;
+
+	/**
+	 * @brief The window metrics, captured once per frame and on window events.
+	 * @see WindowController::metricsForWindow(SDL_Window *)
+	 */
+	WindowMetrics metrics;
+
 	/**
 	 * @brief The Renderer.
 	 */
@@ -79,6 +134,17 @@ struct WindowControllerInterface {
 	 */
 	ObjectInterface objectInterface;
 
+	/**
+	 * @static
+	 * @fn const WindowMetrics *WindowController::currentMetrics(void)
+	 * @return The metrics made current on the calling thread, or `NULL`.
+	 * @remarks A WindowController makes its metrics current while it renders or responds to an
+	 * event, and LayoutQueue threads make the metrics of the dispatching thread current while they
+	 * lay out. This is a cheap, thread-local accessor.
+	 * @memberof WindowController
+	 */
+	const WindowMetrics *(*currentMetrics)(void);
+
 	/**
 	 * @fn WindowController *WindowController::initWithWindow(WindowController *self, SDL_Window *window)
 	 * @brief Initializes this WindowController with the given window.
@@ -89,6 +155,28 @@ struct WindowControllerInterface {
 	 */
 	WindowController *(*initWithWindow)(WindowController *self, SDL_Window *window);
 
+	/**
+	 * @static
+	 * @fn const WindowMetrics *WindowController::makeMetricsCurrent(const WindowMetrics *metrics)
+	 * @brief Makes the given metrics current on the calling thread.
+	 * @param metrics The metrics, or `NULL`.
+	 * @return The previously current metrics, which the caller should restore.
+	 * @memberof WindowController
+	 */
+	const WindowMetrics *(*makeMetricsCurrent)(const WindowMetrics *metrics);
+
+	/**
+	 * @static
+	 * @fn const WindowMetrics *WindowController::metricsForWindow(SDL_Window *window)
+	 * @param window The window, or `NULL` for the current metrics.
+	 * @return The current metrics if they belong to `window`, else the metrics of the
+	 * WindowController managing `window`, or `NULL`.
+	 * @remarks Looking up another window's WindowController is not thread safe, and should only be
+	 * done on the main thread.
+	 * @memberof WindowController
+	 */
+	const WindowMetrics *(*metricsForWindow)(SDL_Window *window);
+
 	/**
 	 * @fn void WindowController::setRenderer(WindowController *self, Renderer *renderer)
 	 * @brief Sets this WindowController's Renderer.
@@ -124,6 +212,15 @@ struct WindowControllerInterface {
 	 * @memberof WindowController
 	 */
 	void (*respondToEvent)(WindowController * self, const SDL_Event *event);
+
+	/**
+	 * @fn void WindowController::updateMetrics(WindowController *self)
+	 * @brief Captures this WindowController's window metrics.
+	 * @param self The WindowController.
+	 * @remarks This is called once per frame, and on window events.
+	 * @memberof WindowController
+	 */
+	void (*updateMetrics)(WindowController *self);
 };
 
 /**